@@ -59,6 +59,16 @@ static QString reduceTypeName(const AbstractMetaClass* metaClass)
     return QString();
 }
 
+// Returns true if \p metaClass has a function called \p name, added in the type system or not.
+static bool hasFunctionNamed(const AbstractMetaClass* metaClass, const QString& name)
+{
+    foreach (const AbstractMetaFunction* func, metaClass->functions()) {
+        if (func->name() == name)
+            return true;
+    }
+    return false;
+}
+
 CppGenerator::CppGenerator()
 {
     m_currentErrorCode = 0;
@@ -390,6 +400,16 @@ void CppGenerator::generateClass(QTextStream &s, const AbstractMetaClass *metaCl
 
     if (metaClass->typeEntry()->isValue())
         writeCopyFunction(s, metaClass);
+    if (useDeepCopy(metaClass))
+        writeDeepCopyFunctions(s, metaClass);
+    if (isTriviallyCopyable(metaClass))
+        writePickleFunctions(s, metaClass);
+    AbstractMetaFunctionList getters = arrayGetters(metaClass);
+    foreach (const AbstractMetaFunction* func, getters)
+        writeArrayGetterFunction(s, metaClass, func);
+    const AbstractMetaFunction* fromBuffersCtor = bufferConstructor(metaClass);
+    if (fromBuffersCtor)
+        writeFromBuffersFunction(s, metaClass, fromBuffersCtor);
 
     // Write single method definitions
     s << singleMethodDefinitions;
@@ -399,6 +419,26 @@ void CppGenerator::generateClass(QTextStream &s, const AbstractMetaClass *metaCl
     s << methodsDefinitions << endl;
     if (metaClass->typeEntry()->isValue())
         s << INDENT << "{\"__copy__\", (PyCFunction)" << className << "___copy__" << ", METH_NOARGS}," << endl;
+    if (useDeepCopy(metaClass)) {
+        if (!hasFunctionNamed(metaClass, "__deepcopy__"))
+            s << INDENT << "{\"__deepcopy__\", (PyCFunction)" << className << "___deepcopy__" << ", METH_O}," << endl;
+        if (!hasFunctionNamed(metaClass, "copyList"))
+            s << INDENT << "{\"copyList\", (PyCFunction)" << className << "_copyList" << ", METH_O|METH_STATIC}," << endl;
+    }
+    if (isTriviallyCopyable(metaClass)) {
+        if (!hasFunctionNamed(metaClass, "__reduce__")) {
+            s << INDENT << "{\"__reduce__\", (PyCFunction)" << className << "___reduce__" << ", METH_NOARGS}," << endl;
+            s << INDENT << "{\"__setstate__\", (PyCFunction)" << className << "___setstate__" << ", METH_O}," << endl;
+        }
+        s << INDENT << "{\"packList\", (PyCFunction)" << className << "_packList" << ", METH_O|METH_STATIC}," << endl;
+        s << INDENT << "{\"unpackList\", (PyCFunction)" << className << "_unpackList" << ", METH_O|METH_STATIC}," << endl;
+    }
+    foreach (const AbstractMetaFunction* func, getters) {
+        s << INDENT << "{\"" << func->name() << "Array\", (PyCFunction)" << className << '_' << func->name() << "Array";
+        s << ", METH_O|METH_STATIC}," << endl;
+    }
+    if (fromBuffersCtor)
+        s << INDENT << "{\"fromBuffers\", (PyCFunction)" << className << "_fromBuffers" << ", METH_VARARGS|METH_STATIC}," << endl;
     s << INDENT << "{0} // Sentinel" << endl;
     s << "};" << endl << endl;
 
@@ -493,6 +533,9 @@ void CppGenerator::generateClass(QTextStream &s, const AbstractMetaClass *metaCl
     if (!metaClass->typeEntry()->hashFunction().isEmpty())
         writeHashFunction(s, metaClass);
 
+    if (!bufferExporterFunction(metaClass).isEmpty())
+        writeBufferProtocolFunctions(s, metaClass);
+
     // Write tp_traverse and tp_clear functions.
     writeTpTraverseFunction(s, metaClass);
     writeTpClearFunction(s, metaClass);
@@ -924,8 +967,16 @@ void CppGenerator::writeMethodWrapperPreamble(QTextStream& s, OverloadData& over
         }
         // Declare pointer for the underlying C++ object.
         s << INDENT << "::";
-        s << (shouldGenerateCppWrapper(ownerClass) ? wrapperName(ownerClass) : ownerClass->qualifiedCppName());
+        bool useWrapperPointer = shouldGenerateCppWrapper(ownerClass) && !useCppWrapperOnlyForSubclasses(ownerClass);
+        s << (useWrapperPointer ? wrapperName(ownerClass) : ownerClass->qualifiedCppName());
         s << "* cptr = 0;" << endl;
+        if (useInlineStorage(ownerClass)) {
+            s << INDENT << "void* inlineStorage = Shiboken::Object::inlineStorage(sbkSelf, Shiboken::SbkType< ::";
+            s << ownerClass->qualifiedCppName() << " >());" << endl;
+            s << INDENT << "if (!inlineStorage)" << endl;
+            Indentation indent(INDENT);
+            s << INDENT << "return " << m_currentErrorCode << ';' << endl;
+        }
 
         initPythonArguments = maxArgs > 0;
         usesNamedArguments = !ownerClass->isQObject() && overloadData.hasArgumentWithDefaultValue();
@@ -942,8 +993,28 @@ void CppGenerator::writeMethodWrapperPreamble(QTextStream& s, OverloadData& over
         usesNamedArguments = rfunc->isCallOperator() || overloadData.hasArgumentWithDefaultValue();
     }
 
-    if (maxArgs > 0)
+    // Temporaries created by implicit conversions of pointer and reference arguments.
+    foreach (const AbstractMetaFunction* func, overloadData.overloads()) {
+        bool useConversionArena = false;
+        for (int argIdx = 0; argIdx < func->arguments().count() && !useConversionArena; ++argIdx)
+            useConversionArena = argumentUsesConversionArena(func, argIdx + 1);
+        if (useConversionArena) {
+            s << INDENT << "Shiboken::ConversionArena " CONVERSION_ARENA_VAR ";" << endl;
+            break;
+        }
+    }
+
+    if (maxArgs > 0) {
         s << INDENT << "int overloadId = -1;" << endl;
+        // Implicit conversions matched by the overload decisor.
+        foreach (QString conversionIndexVar, implicitConversionIndexVariables(overloadData))
+            s << INDENT << "int " << conversionIndexVar << " = -1;" << endl;
+        // Containers converted by the overload decisor while checking their items.
+        QMap<QString, QString> convertedArgumentVars = convertedArgumentVariables(overloadData);
+        QMap<QString, QString>::const_iterator it = convertedArgumentVars.constBegin();
+        for (; it != convertedArgumentVars.constEnd(); ++it)
+            s << INDENT << "Shiboken::ConvertedArgument< " << it.value() << " > " << it.key() << ';' << endl;
+    }
 
     if (usesNamedArguments)
         s << INDENT << "int numNamedArgs = (kwds ? PyDict_Size(kwds) : 0);" << endl;
@@ -990,7 +1061,7 @@ void CppGenerator::writeConstructorWrapper(QTextStream& s, const AbstractMetaFun
 
     s << INDENT << "SbkObject* sbkSelf = reinterpret_cast<SbkObject*>(" PYTHON_SELF_VAR ");" << endl;
 
-    if (metaClass->isAbstract() || metaClass->baseClassNames().size() > 1) {
+    if (metaClass->isAbstract() || metaClass->baseClassNames().size() > 1 || useCppWrapperOnlyForSubclasses(metaClass)) {
         s << INDENT << "SbkObjectType* type = reinterpret_cast<SbkObjectType*>(" PYTHON_SELF_VAR "->ob_type);" << endl;
         s << INDENT << "SbkObjectType* myType = reinterpret_cast<SbkObjectType*>(" << cpythonTypeNameExt(metaClass->typeEntry()) << ");" << endl;
     }
@@ -1045,7 +1116,18 @@ void CppGenerator::writeConstructorWrapper(QTextStream& s, const AbstractMetaFun
     s << INDENT << "if (PyErr_Occurred() || !Shiboken::Object::setCppPointer(sbkSelf, Shiboken::SbkType< ::" << metaClass->qualifiedCppName() << " >(), cptr)) {" << endl;
     {
         Indentation indent(INDENT);
-        s << INDENT << "delete cptr;" << endl;
+        if (useInlineStorage(metaClass)) {
+            s << INDENT << "if (cptr == inlineStorage)" << endl;
+            {
+                Indentation indent(INDENT);
+                s << INDENT << "Shiboken::callCppInlineDestructor< ::" << metaClass->qualifiedCppName() << " >(cptr);" << endl;
+            }
+            s << INDENT << "else" << endl;
+            Indentation indent(INDENT);
+            s << INDENT << "delete cptr;" << endl;
+        } else {
+            s << INDENT << "delete cptr;" << endl;
+        }
         s << INDENT << "return " << m_currentErrorCode << ';' << endl;
     }
     s << INDENT << '}' << endl;
@@ -1059,8 +1141,13 @@ void CppGenerator::writeConstructorWrapper(QTextStream& s, const AbstractMetaFun
     // (first "1") and the flag indicating that the Python wrapper holds an C++ wrapper
     // is marked as true (the second "1"). Otherwise the default values apply:
     // Python owns it and C++ wrapper is false.
-    if (shouldGenerateCppWrapper(overloads.first()->ownerClass()))
+    if (useCppWrapperOnlyForSubclasses(metaClass)) {
+        s << INDENT << "if (type != myType)" << endl;
+        Indentation indent(INDENT);
+        s << INDENT << "Shiboken::Object::setHasCppWrapper(sbkSelf, true);" << endl;
+    } else if (shouldGenerateCppWrapper(overloads.first()->ownerClass())) {
         s << INDENT << "Shiboken::Object::setHasCppWrapper(sbkSelf, true);" << endl;
+    }
     s << INDENT << "Shiboken::BindingManager::instance().registerWrapper(sbkSelf, cptr);" << endl;
 
     // Create metaObject and register signal/slot
@@ -1513,6 +1600,55 @@ void CppGenerator::writeTypeCheck(QTextStream& s, const OverloadData* overloadDa
     bool numberType = numericTypes.count() == 1 || ShibokenGenerator::isPyInt(argType);
     QString customType = (overloadData->hasArgumentTypeReplace() ? overloadData->argumentTypeReplaced() : "");
     bool rejectNull = shouldRejectNullPointerArgument(overloadData->referenceFunction(), overloadData->argPos());
+
+    // Byte view arguments accept anything that exposes its bytes.
+    foreach (const AbstractMetaFunction* func, overloadData->overloads()) {
+        const AbstractMetaArgument* arg = overloadData->argument(func);
+        if (arg && isByteViewArgument(func, arg->argumentIndex() + 1)) {
+            s << "Shiboken::Buffer::ByteView::check(" << argumentName << ')';
+            return;
+        }
+    }
+
+    // UTF-8 string arguments accept unicode objects besides str, and None for C strings.
+    foreach (const AbstractMetaFunction* func, overloadData->overloads()) {
+        const AbstractMetaArgument* arg = overloadData->argument(func);
+        if (arg && isUtf8StringArgument(func, arg->argumentIndex() + 1)) {
+            s << '(';
+            if (arg->type()->indirections() > 0)
+                s << argumentName << " == Py_None || ";
+            s << "Shiboken::String::check(" << argumentName << "))";
+            return;
+        }
+    }
+
+    // Converts containers while checking them, for the argument conversion to use the result.
+    if (customType.isEmpty()) {
+        QMap<QString, QString> convertedArgumentVars = convertedArgumentVariables(*overloadData->headOverloadData());
+        foreach (const AbstractMetaFunction* func, overloadData->overloads()) {
+            const AbstractMetaArgument* arg = overloadData->argument(func);
+            QString convertedArgumentVar = arg ? convertedArgumentVariable(func, arg->argumentIndex() + 1) : QString();
+            if (convertedArgumentVars.contains(convertedArgumentVar)) {
+                s << convertedArgumentVar << ".check(" << argumentName << ')';
+                return;
+            }
+        }
+    }
+
+    // Records the matched implicit conversion, for the argument conversion to use it.
+    if (customType.isEmpty()) {
+        QStringList conversionIndexVars = implicitConversionIndexVariables(*overloadData->headOverloadData());
+        foreach (const AbstractMetaFunction* func, overloadData->overloads()) {
+            const AbstractMetaArgument* arg = overloadData->argument(func);
+            QString conversionIndexVar = arg ? implicitConversionIndexVariable(func, arg->argumentIndex() + 1) : QString();
+            if (conversionIndexVars.contains(conversionIndexVar)) {
+                s << '(' << conversionIndexVar << " = ";
+                writeBaseConversion(s, argType);
+                s << "implicitConversionIndex(" << argumentName << ")) >= 0";
+                return;
+            }
+        }
+    }
     writeTypeCheck(s, argType, argumentName, numberType, customType, rejectNull);
 }
 
@@ -1520,13 +1656,39 @@ void CppGenerator::writeArgumentConversion(QTextStream& s,
                                            const AbstractMetaType* argType,
                                            const QString& argName, const QString& pyArgName,
                                            const AbstractMetaClass* context,
-                                           const QString& defaultValue)
+                                           const QString& defaultValue,
+                                           bool useConversionArena,
+                                           const QString& conversionIndexVar)
 {
     if (argType->typeEntry()->isCustom() || argType->typeEntry()->isVarargs())
         return;
     if (isWrapperType(argType))
         writeInvalidPyObjectCheck(s, pyArgName);
-    writePythonToCppTypeConversion(s, argType, pyArgName, argName, context, defaultValue);
+    if (defaultValue.isEmpty() && !useConversionArena && isSharedListArgument(argType)) {
+        // Shared lists are handed to C++ without copies, and see the changes made by it.
+        QString typeName = translateTypeForWrapperMethod(argType, context, getConverterOptions(argType)).trimmed();
+        QString localName = QString("%1_local").arg(argName);
+        s << INDENT << typeName << ' ' << localName << ';' << endl;
+        s << INDENT << typeName << "& " << argName << " = Shiboken::toCppReference(";
+        s << pyArgName << ", " << localName << ");" << endl;
+        return;
+    }
+    writePythonToCppTypeConversion(s, argType, pyArgName, argName, context, defaultValue,
+                                   useConversionArena, conversionIndexVar);
+}
+
+bool CppGenerator::isSharedListArgument(const AbstractMetaType* argType)
+{
+    if (!argType->isContainer() || !argType->isReference() || argType->indirections() > 0)
+        return false;
+    switch (static_cast<const ContainerTypeEntry*>(argType->typeEntry())->type()) {
+        case ContainerTypeEntry::ListContainer:
+        case ContainerTypeEntry::LinkedListContainer:
+        case ContainerTypeEntry::VectorContainer:
+            return true;
+        default:
+            return false;
+    }
 }
 
 const AbstractMetaType* CppGenerator::getArgumentType(const AbstractMetaFunction* func, int argPos)
@@ -1556,14 +1718,21 @@ void CppGenerator::writePythonToCppTypeConversion(QTextStream& s,
                                                   const QString& pyIn,
                                                   const QString& cppOut,
                                                   const AbstractMetaClass* context,
-                                                  const QString& defaultValue)
+                                                  const QString& defaultValue,
+                                                  bool useConversionArena,
+                                                  const QString& conversionIndexVar)
 {
     if (type->typeEntry()->isCustom() || type->typeEntry()->isVarargs())
         return;
 
     QString conversion;
     QTextStream c(&conversion);
-    writeToCppConversion(c, type, context, pyIn);
+    if (useConversionArena)
+        c << cpythonToCppConversionFunction(type, context) << '(' << pyIn << ", " CONVERSION_ARENA_VAR ")";
+    else if (!conversionIndexVar.isEmpty())
+        c << cpythonToCppConversionFunction(type, context) << '(' << pyIn << ", " << conversionIndexVar << ')';
+    else
+        writeToCppConversion(c, type, context, pyIn);
 
     QString typeName;
     QString cppOutAux = QString("%1_tmp").arg(cppOut);
@@ -1866,7 +2035,51 @@ void CppGenerator::writeSingleFunctionCall(QTextStream& s, const OverloadData& o
         const AbstractMetaArgument* arg = func->arguments().at(argIdx);
         QString defaultValue = guessScopeForDefaultValue(func, arg);
 
-        writeArgumentConversion(s, argType, argName, pyArgName, implementingClass, defaultValue);
+        if (isByteViewArgument(func, argIdx + 1)) {
+            QString typeName = argType->cppSignature();
+            s << INDENT << "Shiboken::Buffer::ByteView " << argName << "_view(" << pyArgName << ");" << endl;
+            s << INDENT << typeName << ' ' << argName << " = ";
+            if (!defaultValue.isEmpty())
+                s << pyArgName << " ? ";
+            s << "static_cast<" << typeName << " >(" << argName << "_view.data())";
+            if (!defaultValue.isEmpty())
+                s << " : " << defaultValue;
+            s << ';' << endl;
+            continue;
+        }
+
+        if (isUtf8StringArgument(func, argIdx + 1)) {
+            QString utf8Name = argName + "_utf8";
+            s << INDENT << "const char* " << utf8Name << " = ";
+            if (!defaultValue.isEmpty())
+                s << pyArgName << " ? ";
+            s << "Shiboken::String::toUtf8(" << pyArgName << ", " CONVERSION_ARENA_VAR ")";
+            if (!defaultValue.isEmpty())
+                s << " : " << (argType->indirections() > 0 ? defaultValue : QString("0"));
+            s << ';' << endl;
+            if (argType->indirections() > 0) {
+                s << INDENT << "const char* " << argName << " = " << utf8Name << ';' << endl;
+            } else {
+                s << INDENT << "::std::string " << argName << " = " << utf8Name << " ? ::std::string(" << utf8Name << ") : ";
+                s << (defaultValue.isEmpty() ? QString("::std::string()") : QString("::std::string(%1)").arg(defaultValue)) << ';' << endl;
+            }
+            continue;
+        }
+
+        QString convertedArgumentVar = convertedArgumentVariable(func, argIdx + 1);
+        if (!convertedArgumentVar.isEmpty()) {
+            QString typeName = convertedArgumentType(func, argIdx + 1);
+            QString conversion = QString("%1.toCpp(%2)").arg(convertedArgumentVar).arg(pyArgName);
+            if (defaultValue.isEmpty())
+                s << INDENT << typeName << "& " << argName << " = " << conversion << ';' << endl;
+            else
+                s << INDENT << typeName << ' ' << argName << " = " << pyArgName << " ? " << conversion << " : " << defaultValue << ';' << endl;
+            continue;
+        }
+
+        writeArgumentConversion(s, argType, argName, pyArgName, implementingClass, defaultValue,
+                                argumentUsesConversionArena(func, argIdx + 1),
+                                implicitConversionIndexVariable(func, argIdx + 1));
     }
 
     s << endl;
@@ -2032,8 +2245,11 @@ void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* f
                     removedArgs++;
 
                     // If have conversion rules I will use this for removed args
+                    QString byteViewSize = byteViewSizeExpression(func, i + 1);
                     if (hasConversionRule) {
                         userArgs << QString("%1"CONV_RULE_OUT_VAR_SUFFIX).arg(arg->name());
+                    } else if (!byteViewSize.isEmpty()) {
+                        userArgs << byteViewSize;
                     } else {
                        if (arg->defaultValueExpression().isEmpty())
                            badModifications = true;
@@ -2060,14 +2276,18 @@ void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* f
                 const AbstractMetaArgument* arg = func->arguments().at(i);
                 bool defValModified = arg->defaultValueExpression() != arg->originalDefaultValueExpression();
                 bool hasConversionRule = !func->conversionRule(TypeSystem::NativeCode, arg->argumentIndex() + 1).isEmpty();
-                if (argsClear && !defValModified && !hasConversionRule)
+                // The size of a byte view is only known when the view argument was converted.
+                QString byteViewSize = i - 1 < maxArgs + removedArgs ? byteViewSizeExpression(func, i + 1) : QString();
+                if (argsClear && !defValModified && !hasConversionRule && byteViewSize.isEmpty())
                     continue;
                 else
                     argsClear = false;
 
                 otherArgsModified |= defValModified || hasConversionRule || func->argumentRemoved(i + 1);
 
-                if (!arg->defaultValueExpression().isEmpty())
+                if (!byteViewSize.isEmpty())
+                    otherArgs.prepend(byteViewSize);
+                else if (!arg->defaultValueExpression().isEmpty())
                     otherArgs.prepend(guessScopeForDefaultValue(func, arg));
                 else if (hasConversionRule)
                     otherArgs.prepend(QString("%1"CONV_RULE_OUT_VAR_SUFFIX).arg(arg->name()));
@@ -2125,16 +2345,23 @@ void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* f
             if (func->isConstructor() || func->isCopyConstructor()) {
                 isCtor = true;
                 QString className = wrapperName(func->ownerClass());
+                // Value types with inline storage are constructed inside the Python wrapper.
+                QString newOperator = useInlineStorage(func->ownerClass()) ? "new (inlineStorage) ::" : "new ::";
+                // Objects of the exact bound type need no wrapper to dispatch virtual calls to Python.
+                if (useCppWrapperOnlyForSubclasses(func->ownerClass()) && !func->isProtected())
+                    newOperator.prepend(QString("type == myType ? new ::%1(%2) : ")
+                                        .arg(func->ownerClass()->qualifiedCppName())
+                                        .arg(func->isCopyConstructor() && maxArgs == 1 ? QString(CPP_ARG0) : userArgs.join(", ")));
 
                 if (func->isCopyConstructor() && maxArgs == 1) {
-                    mc << "new ::" << className << '(' << CPP_ARG0 << ')';
+                    mc << newOperator << className << '(' << CPP_ARG0 << ')';
                 } else {
                     QString ctorCall = className + '(' + userArgs.join(", ") + ')';
                     if (usePySideExtensions() && func->ownerClass()->isQObject()) {
                         s << INDENT << "void* addr = PySide::nextQObjectMemoryAddr();" << endl;
                         mc << "addr ? new (addr) ::" << ctorCall << " : new ::" << ctorCall;
                     } else {
-                        mc << "new ::" << ctorCall;
+                        mc << newOperator << ctorCall;
                     }
                 }
 
@@ -2193,9 +2420,19 @@ void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* f
         }
 
         if (!injectedCodeCallsCppFunction(func)) {
+            bool wrapWithoutCopy = !isCtor && canWrapReturnValueWithoutCopy(func);
+            bool returnLazyMap = !isCtor && canReturnLazyMap(func);
+            bool returnSequenceView = !isCtor && canReturnSequenceView(func);
+            bool returnArray = !isCtor && canReturnArray(func);
+            bool returnCachedString = !isCtor && canReturnCachedString(func);
             s << INDENT << BEGIN_ALLOW_THREADS << endl << INDENT;
             if (isCtor) {
                 s << "cptr = ";
+            } else if (wrapWithoutCopy) {
+                // The compiler elides the copy from the returned temporary to the new object.
+                QString typeName = "::" + func->type()->typeEntry()->qualifiedCppName();
+                methodCall = QString("new %1(%2)").arg(typeName).arg(methodCall);
+                s << typeName << "* " CPP_RETURN_VAR " = ";
             } else if (func->type() && !func->isInplaceOperator()) {
                 bool writeReturnType = true;
                 if (avoidProtectedHack()) {
@@ -2222,7 +2459,23 @@ void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* f
             if (!isCtor && !func->isInplaceOperator() && func->type()
                 && !injectedCodeHasReturnValueAttribution(func, TypeSystem::TargetLangCode)) {
                 s << INDENT << PYTHON_RETURN_VAR " = ";
-                writeToPythonConversion(s, func->type(), func->ownerClass(), CPP_RETURN_VAR);
+                if (wrapWithoutCopy) {
+                    s << "Shiboken::createWrapper< ::" << func->type()->typeEntry()->qualifiedCppName();
+                    s << " >(" CPP_RETURN_VAR ", true, true)";
+                } else if (returnLazyMap) {
+                    // The proxy takes the contents of the returned map.
+                    s << "Shiboken::createMapProxy(" CPP_RETURN_VAR ")";
+                } else if (returnArray) {
+                    // The array takes the contents of the returned vector.
+                    s << "Shiboken::createArray(" CPP_RETURN_VAR ")";
+                } else if (returnSequenceView) {
+                    // The view takes the contents of the returned list.
+                    s << "Shiboken::createSequenceView(" CPP_RETURN_VAR ")";
+                } else if (returnCachedString) {
+                    s << "Shiboken::String::fromCachedCString(" CPP_RETURN_VAR ")";
+                } else {
+                    writeToPythonConversion(s, func->type(), func->ownerClass(), CPP_RETURN_VAR);
+                }
                 s << ';' << endl;
             }
         }
@@ -2328,6 +2581,96 @@ void CppGenerator::writeMethodCall(QTextStream& s, const AbstractMetaFunction* f
     writeParentChildManagement(s, func, !hasReturnPolicy);
 }
 
+bool CppGenerator::hasDefaultReturnValueConversion(const AbstractMetaFunction* func)
+{
+    if (func->type()->typeEntry()->hasNativeConversionRule()
+        || !func->typeReplaced(0).isEmpty() || !func->conversionRule(TypeSystem::TargetLangCode, 0).isEmpty()
+        || injectedCodeHasReturnValueAttribution(func, TypeSystem::TargetLangCode)) {
+        return false;
+    }
+
+    // Injected code expects the returned value in a variable of the original type.
+    foreach (CodeSnip snip, func->injectedCodeSnips(CodeSnip::Any, TypeSystem::TargetLangCode)) {
+        if (snip.code().contains("%0"))
+            return false;
+    }
+    return true;
+}
+
+bool CppGenerator::canWrapReturnValueWithoutCopy(const AbstractMetaFunction* func)
+{
+    const AbstractMetaType* type = func->type();
+    if (!type || func->isInplaceOperator() || !isWrapperType(type) || !type->typeEntry()->isValue()
+        || type->isReference() || type->indirections() > 0 || !hasDefaultReturnValueConversion(func)) {
+        return false;
+    }
+
+    // Types with inline storage must be copied inside their wrappers anyway.
+    const AbstractMetaClass* metaClass = classes().findClass(type->typeEntry());
+    return !metaClass || !useInlineStorage(metaClass);
+}
+
+bool CppGenerator::canReturnLazyMap(const AbstractMetaFunction* func)
+{
+    const AbstractMetaType* type = func->type();
+    // The proxy takes the returned map by non-const reference, so const maps are returned as dicts.
+    if (!type || func->isInplaceOperator() || !type->isContainer() || type->isConstant()
+        || type->isReference() || type->indirections() > 0 || !useLazyMapReturn(func)) {
+        return false;
+    }
+    const ContainerTypeEntry* ctype = static_cast<const ContainerTypeEntry*>(type->typeEntry());
+    if (ctype->type() != ContainerTypeEntry::MapContainer && ctype->type() != ContainerTypeEntry::HashContainer)
+        return false;
+    return hasDefaultReturnValueConversion(func);
+}
+
+bool CppGenerator::canReturnArray(const AbstractMetaFunction* func)
+{
+    const AbstractMetaType* type = func->type();
+    // The array takes the returned vector by non-const reference.
+    if (!type || func->isInplaceOperator() || !type->isContainer() || type->isConstant()
+        || type->isReference() || type->indirections() > 0 || !useArrayReturn(func)) {
+        return false;
+    }
+    if (static_cast<const ContainerTypeEntry*>(type->typeEntry())->type() != ContainerTypeEntry::VectorContainer
+        || type->instantiations().size() != 1) {
+        return false;
+    }
+    // std::vector<bool> doesn't store its items contiguously.
+    const AbstractMetaType* itemType = type->instantiations().first();
+    if (!isNumber(itemType) || itemType->indirections() > 0 || cpythonBaseName(itemType) == "PyBool")
+        return false;
+    return hasDefaultReturnValueConversion(func);
+}
+
+bool CppGenerator::canReturnCachedString(const AbstractMetaFunction* func)
+{
+    const AbstractMetaType* type = func->type();
+    if (!type || func->isInplaceOperator() || !useCachedStringReturn(func))
+        return false;
+    if (!isCString(type) && (type->typeEntry()->qualifiedCppName() != "std::string" || type->indirections() > 0))
+        return false;
+    return hasDefaultReturnValueConversion(func);
+}
+
+bool CppGenerator::canReturnSequenceView(const AbstractMetaFunction* func)
+{
+    const AbstractMetaType* type = func->type();
+    // The view takes the returned container by non-const reference.
+    if (!type || func->isInplaceOperator() || !type->isContainer() || type->isConstant()
+        || type->isReference() || type->indirections() > 0 || !useSequenceViewReturn(func)) {
+        return false;
+    }
+    switch (static_cast<const ContainerTypeEntry*>(type->typeEntry())->type()) {
+        case ContainerTypeEntry::ListContainer:
+        case ContainerTypeEntry::LinkedListContainer:
+        case ContainerTypeEntry::VectorContainer:
+            return hasDefaultReturnValueConversion(func);
+        default:
+            return false;
+    }
+}
+
 QStringList CppGenerator::getAncestorMultipleInheritance(const AbstractMetaClass* metaClass)
 {
     QStringList result;
@@ -2597,7 +2940,11 @@ void CppGenerator::writeClassDefinition(QTextStream& s, const AbstractMetaClass*
     s << INDENT << "PyObject_HEAD_INIT(&SbkObjectType_Type)" << endl;
     s << INDENT << "/*ob_size*/             0," << endl;
     s << INDENT << "/*tp_name*/             \"" << getClassTargetFullName(metaClass) << "\"," << endl;
-    s << INDENT << "/*tp_basicsize*/        sizeof(SbkObject)," << endl;
+    s << INDENT << "/*tp_basicsize*/        ";
+    if (useInlineStorage(metaClass))
+        s << "SBK_INLINE_STORAGE_OFFSET + sizeof(::" << cppClassName << ")," << endl;
+    else
+        s << "sizeof(SbkObject)," << endl;
     s << INDENT << "/*tp_itemsize*/         0," << endl;
     s << INDENT << "/*tp_dealloc*/          " << tp_dealloc << ',' << endl;
     s << INDENT << "/*tp_print*/            0," << endl;
@@ -2853,6 +3200,172 @@ void CppGenerator::writeCopyFunction(QTextStream& s, const AbstractMetaClass *me
     s << endl;
 }
 
+void CppGenerator::writeDeepCopyFunctions(QTextStream& s, const AbstractMetaClass* metaClass)
+{
+    QString className = cpythonTypeName(metaClass).replace(QRegExp("_Type$"), "");
+    QString cppName = "::" + metaClass->qualifiedCppName();
+    QString typeArgs = QString("reinterpret_cast<SbkObjectType*>(Shiboken::SbkType< %1 >()), &Shiboken::Copy::copyObject< %1 >").arg(cppName);
+
+    // A __deepcopy__ written in the type system, or a copyList from the C++ class, takes precedence.
+    if (!hasFunctionNamed(metaClass, "__deepcopy__")) {
+        s << "static PyObject* " << className << "___deepcopy__(PyObject* " PYTHON_SELF_VAR ", PyObject* " PYTHON_ARG ")" << endl;
+        s << '{' << endl;
+        s << INDENT << "return Shiboken::Copy::deepCopy(" PYTHON_SELF_VAR ", " PYTHON_ARG ", " << typeArgs << ");" << endl;
+        s << '}' << endl << endl;
+    }
+
+    if (!hasFunctionNamed(metaClass, "copyList")) {
+        s << "static PyObject* " << className << "_copyList(PyObject*, PyObject* " PYTHON_ARG ")" << endl;
+        s << '{' << endl;
+        s << INDENT << "return Shiboken::Copy::copyList(" PYTHON_ARG ", " << typeArgs << ");" << endl;
+        s << '}' << endl << endl;
+    }
+}
+
+void CppGenerator::writePickleFunctions(QTextStream& s, const AbstractMetaClass* metaClass)
+{
+    QString className = cpythonTypeName(metaClass).replace(QRegExp("_Type$"), "");
+    QString cppName = "::" + metaClass->qualifiedCppName();
+    QString typeArgs = QString("reinterpret_cast<SbkObjectType*>(Shiboken::SbkType< %1 >()), sizeof(%1)").arg(cppName);
+    QString copyFunction = QString("&Shiboken::Copy::copyObject< %1 >").arg(cppName);
+
+    // A __reduce__ written in the type system takes precedence.
+    if (!hasFunctionNamed(metaClass, "__reduce__")) {
+        s << "static PyObject* " << className << "___reduce__(PyObject* " PYTHON_SELF_VAR ")" << endl;
+        s << '{' << endl;
+        s << INDENT << "return Shiboken::Pickle::reduce(" PYTHON_SELF_VAR ", " << typeArgs << ");" << endl;
+        s << '}' << endl << endl;
+
+        s << "static PyObject* " << className << "___setstate__(PyObject* " PYTHON_SELF_VAR ", PyObject* " PYTHON_ARG ")" << endl;
+        s << '{' << endl;
+        s << INDENT << "return Shiboken::Pickle::setState(" PYTHON_SELF_VAR ", " PYTHON_ARG ", " << typeArgs << ", " << copyFunction << ");" << endl;
+        s << '}' << endl << endl;
+    }
+
+    s << "static PyObject* " << className << "_packList(PyObject*, PyObject* " PYTHON_ARG ")" << endl;
+    s << '{' << endl;
+    s << INDENT << "return Shiboken::Pickle::packList(" PYTHON_ARG ", " << typeArgs << ");" << endl;
+    s << '}' << endl << endl;
+
+    s << "static PyObject* " << className << "_unpackList(PyObject*, PyObject* " PYTHON_ARG ")" << endl;
+    s << '{' << endl;
+    s << INDENT << "return Shiboken::Pickle::unpackList(" PYTHON_ARG ", " << typeArgs << ", " << copyFunction << ");" << endl;
+    s << '}' << endl << endl;
+}
+
+AbstractMetaFunctionList CppGenerator::arrayGetters(const AbstractMetaClass* metaClass)
+{
+    AbstractMetaFunctionList result;
+    QSet<QString> names;
+    foreach (AbstractMetaFunction* func, metaClass->functions()) {
+        if (!useArrayGetter(metaClass, func) || !func->isPublic() || func->isStatic() || func->isConstructor()
+            || func->isOperatorOverload() || func->isModifiedRemoved() || func->isUserAdded()
+            || func->hasInjectedCode() || !func->arguments().isEmpty()) {
+            continue;
+        }
+        const AbstractMetaType* type = func->type();
+        if (!type || !isNumber(type) || type->indirections() > 0 || type->isReference()
+            || cpythonBaseName(type) == "PyBool" || !hasDefaultReturnValueConversion(func)) {
+            continue;
+        }
+        QString name = func->name() + "Array";
+        if (names.contains(name) || hasFunctionNamed(metaClass, name))
+            continue;
+        names << name;
+        result << func;
+    }
+    return result;
+}
+
+void CppGenerator::writeArrayGetterFunction(QTextStream& s, const AbstractMetaClass* metaClass, const AbstractMetaFunction* func)
+{
+    QString className = cpythonTypeName(metaClass).replace(QRegExp("_Type$"), "");
+    QString cppName = "::" + metaClass->qualifiedCppName();
+    QString valueType = func->type()->cppSignature();
+    QString getter = QString("static_cast<%1 (%2::*)()%3>(&%2::%4)")
+                     .arg(valueType).arg(cppName).arg(func->isConstant() ? " const" : "").arg(func->originalName());
+
+    s << "static PyObject* " << className << '_' << func->name() << "Array(PyObject*, PyObject* " PYTHON_ARG ")" << endl;
+    s << '{' << endl;
+    s << INDENT << "return Shiboken::createProjectedArray< " << valueType << ", " << cppName << " >(" PYTHON_ARG ", ";
+    s << "Shiboken::SbkType< " << cppName << " >(), " << getter << ");" << endl;
+    s << '}' << endl << endl;
+}
+
+const AbstractMetaFunction* CppGenerator::bufferConstructor(const AbstractMetaClass* metaClass)
+{
+    if (!useBufferConstructor(metaClass) || hasFunctionNamed(metaClass, "fromBuffers"))
+        return 0;
+
+    const AbstractMetaFunction* result = 0;
+    int resultFloats = 0;
+    foreach (const AbstractMetaFunction* func, metaClass->functions()) {
+        if (!func->isConstructor() || func->isCopyConstructor() || !func->isPublic() || func->isUserAdded()
+            || func->isModifiedRemoved() || func->hasInjectedCode() || func->arguments().isEmpty()) {
+            continue;
+        }
+        bool onlyNumbers = true;
+        int floats = 0;
+        foreach (const AbstractMetaArgument* arg, func->arguments()) {
+            const AbstractMetaType* type = arg->type();
+            int argIndex = arg->argumentIndex() + 1;
+            if (func->argumentRemoved(argIndex) || !func->typeReplaced(argIndex).isEmpty()
+                || !func->conversionRule(TypeSystem::NativeCode, argIndex).isEmpty()
+                || !isNumber(type) || type->indirections() > 0 || (type->isReference() && !type->isConstant())) {
+                onlyNumbers = false;
+                break;
+            }
+            if (cpythonBaseName(type) == "PyFloat")
+                ++floats;
+        }
+        if (!onlyNumbers)
+            continue;
+        if (!result || func->arguments().size() > result->arguments().size()
+            || (func->arguments().size() == result->arguments().size() && floats > resultFloats)) {
+            result = func;
+            resultFloats = floats;
+        }
+    }
+    return result;
+}
+
+void CppGenerator::writeFromBuffersFunction(QTextStream& s, const AbstractMetaClass* metaClass, const AbstractMetaFunction* ctor)
+{
+    QString className = cpythonTypeName(metaClass).replace(QRegExp("_Type$"), "");
+    QString cppName = "::" + metaClass->qualifiedCppName();
+    int numArgs = ctor->arguments().size();
+
+    QStringList ctorArgs;
+    foreach (const AbstractMetaArgument* arg, ctor->arguments()) {
+        ctorArgs << QString("columns[%1].at< %2 >(i)").arg(arg->argumentIndex())
+                                                     .arg(arg->type()->typeEntry()->qualifiedCppName());
+    }
+
+    s << "static PyObject* " << className << "_fromBuffers(PyObject*, PyObject* args)" << endl;
+    s << '{' << endl;
+    s << INDENT << "Shiboken::Buffer::NumberReader columns[" << numArgs << "];" << endl;
+    s << INDENT << "Py_ssize_t count = Shiboken::Buffer::NumberReader::openAll(columns, " << numArgs << ", args, \"fromBuffers\");" << endl;
+    s << INDENT << "if (count < 0)" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "return 0;" << endl;
+    }
+    s << INDENT << "std::vector< " << cppName << " > " CPP_RETURN_VAR ";" << endl;
+    s << INDENT << CPP_RETURN_VAR ".reserve(count);" << endl;
+    s << INDENT << "for (Py_ssize_t i = 0; i < count; ++i)" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << CPP_RETURN_VAR ".push_back(" << cppName << '(' << ctorArgs.join(", ") << "));" << endl;
+    }
+    s << INDENT << "if (PyErr_Occurred())" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "return 0;" << endl;
+    }
+    s << INDENT << "return Shiboken::createSequenceView(" CPP_RETURN_VAR ");" << endl;
+    s << '}' << endl << endl;
+}
+
 void CppGenerator::writeGetterFunction(QTextStream& s, const AbstractMetaField* metaField)
 {
     ErrorCode errorCode(0);
@@ -3420,6 +3933,15 @@ void CppGenerator::writeClassRegister(QTextStream& s, const AbstractMetaClass* m
         s << endl;
     }
 
+    if (!bufferExporterFunction(metaClass).isEmpty()) {
+        s << INDENT << "// type supports buffer protocol" << endl;
+        s << "#if PY_VERSION_HEX >= 0x02060000" << endl;
+        s << INDENT << pyTypeName << ".super.ht_type.tp_as_buffer = &" << cpythonBaseName(metaClass) << "_BufferProcs;" << endl;
+        s << INDENT << pyTypeName << ".super.ht_type.tp_flags |= Py_TPFLAGS_HAVE_NEWBUFFER;" << endl;
+        s << "#endif" << endl;
+        s << endl;
+    }
+
     s << INDENT << cpythonTypeNameExt(classTypeEntry);
     s << " = reinterpret_cast<PyTypeObject*>(&" << pyTypeName << ");" << endl;
     s << endl;
@@ -3452,7 +3974,8 @@ void CppGenerator::writeClassRegister(QTextStream& s, const AbstractMetaClass* m
         // Set destructor function
         if (!metaClass->isNamespace() && !metaClass->hasPrivateDestructor()) {
             QString dtorClassName = metaClass->qualifiedCppName();
-            if ((avoidProtectedHack() && metaClass->hasProtectedDestructor()) || classTypeEntry->isValue())
+            if (((avoidProtectedHack() && metaClass->hasProtectedDestructor()) || classTypeEntry->isValue())
+                && !useCppWrapperOnlyForSubclasses(metaClass))
                 dtorClassName = wrapperName(metaClass);
             s << ", &Shiboken::callCppDestructor< ::" << dtorClassName << " >";
         } else if (metaClass->baseClass() || hasEnclosingClass) {
@@ -3477,6 +4000,21 @@ void CppGenerator::writeClassRegister(QTextStream& s, const AbstractMetaClass* m
     }
     s << INDENT << '}' << endl << endl;
 
+    if (useInlineStorage(metaClass)) {
+        s << INDENT << "Shiboken::ObjectType::setInlineDestructorFunction(&" << pyTypeName;
+        s << ", &Shiboken::callCppInlineDestructor< ::" << metaClass->qualifiedCppName() << " >);" << endl << endl;
+    }
+
+    // Memory accounting for __sizeof__, class level code injections may set a more accurate function.
+    if (!metaClass->isNamespace()) {
+        s << INDENT << "Shiboken::ObjectType::setCppSizeFunction(&" << pyTypeName;
+        s << ", &Shiboken::cppObjectSize< ::" << metaClass->qualifiedCppName() << " >);" << endl << endl;
+    }
+
+    // Buffer exporters are also seen by array consumers, without depending on NumPy.
+    if (!bufferExporterFunction(metaClass).isEmpty())
+        s << INDENT << "Shiboken::Buffer::addArrayInterface(&" << pyTypeName << ".super.ht_type);" << endl << endl;
+
     // class inject-code target/beginning
     if (!classTypeEntry->codeSnips().isEmpty()) {
         writeCodeSnips(s, classTypeEntry->codeSnips(), CodeSnip::Beginning, TypeSystem::TargetLangCode, metaClass);
@@ -4023,6 +4561,195 @@ static ArgumentOwner getArgumentOwner(const AbstractMetaFunction* func, int argI
     return argOwner;
 }
 
+bool CppGenerator::argumentUsesConversionArena(const AbstractMetaFunction* func, int argIndex)
+{
+    // Unicode strings may be encoded into the arena.
+    if (isUtf8StringArgument(func, argIndex))
+        return true;
+    if (func->argumentRemoved(argIndex) || !func->conversionRule(TypeSystem::NativeCode, argIndex).isEmpty())
+        return false;
+
+    const AbstractMetaType* argType = getArgumentType(func, argIndex);
+    if (!argType || !isWrapperType(argType) || !argType->typeEntry()->isValue())
+        return false;
+    if (argType->indirections() != 1 && !(argType->isReference() && !argType->isConstant()))
+        return false;
+
+    // The converted object must outlive the call if its ownership goes somewhere else.
+    // The modifications are checked directly so that free functions are covered too.
+    foreach (FunctionModification funcMod, func->modifications()) {
+        foreach (ArgumentModification argMod, funcMod.argument_mods) {
+            if (argMod.index == argIndex
+                && (!argMod.ownerships.isEmpty() || !argMod.referenceCounts.isEmpty()
+                    || argMod.owner.index != ArgumentOwner::InvalidIndex)) {
+                return false;
+            }
+        }
+    }
+    if (func->ownerClass() && getArgumentOwner(func, argIndex).index != ArgumentOwner::InvalidIndex)
+        return false;
+
+    // A returned pointer or reference to the argument is wrapped without being copied.
+    const AbstractMetaType* returnType = func->type();
+    if (returnType && (returnType->indirections() > 0 || returnType->isReference())
+        && returnType->typeEntry() == argType->typeEntry()) {
+        return false;
+    }
+
+    // Any function but a const method may keep a pointer argument, e.g. a setter
+    // or a free function storing it in a global.
+    if (argType->indirections() > 0 && !(func->ownerClass() && !func->isStatic() && func->isConstant()))
+        return false;
+    return true;
+}
+
+QString CppGenerator::implicitConversionIndexVariable(const AbstractMetaFunction* func, int argIndex)
+{
+    if (func->argumentRemoved(argIndex) || !func->conversionRule(TypeSystem::NativeCode, argIndex).isEmpty()
+        || !func->typeReplaced(argIndex).isEmpty()) {
+        return QString();
+    }
+
+    // Only values and const references are converted by the generated Converter<T>::toCpp.
+    const AbstractMetaType* argType = func->arguments().at(argIndex - 1)->type();
+    const TypeEntry* typeEntry = argType->typeEntry();
+    if (!typeEntry->isValue() || typeEntry->hasNativeConversionRule() || argType->indirections() > 0
+        || (argType->isReference() && !argType->isConstant())) {
+        return QString();
+    }
+    bool hasImplicitConversions = false;
+    foreach (const AbstractMetaFunction* conversion, implicitConversions(typeEntry)) {
+        if (!conversion->isUserAdded()) {
+            hasImplicitConversions = true;
+            break;
+        }
+    }
+    if (!hasImplicitConversions)
+        return QString();
+
+    int argPos = argIndex - 1;
+    for (int i = 1; i < argIndex; ++i) {
+        if (func->argumentRemoved(i))
+            --argPos;
+    }
+    return QString("conversionIndex%1_%2").arg(argPos).arg(QString(typeEntry->qualifiedCppName()).replace("::", "_"));
+}
+
+QStringList CppGenerator::implicitConversionIndexVariables(const OverloadData& overloadData)
+{
+    QStringList result;
+    foreach (const AbstractMetaFunction* func, overloadData.overloads()) {
+        for (int argIndex = 1; argIndex <= func->arguments().count(); ++argIndex) {
+            QString conversionIndexVar = implicitConversionIndexVariable(func, argIndex);
+            if (!conversionIndexVar.isEmpty() && !result.contains(conversionIndexVar))
+                result << conversionIndexVar;
+        }
+    }
+    return result;
+}
+
+QString CppGenerator::convertedArgumentType(const AbstractMetaFunction* func, int argIndex)
+{
+    if (func->argumentRemoved(argIndex) || !func->conversionRule(TypeSystem::NativeCode, argIndex).isEmpty()
+        || !func->typeReplaced(argIndex).isEmpty()) {
+        return QString();
+    }
+
+    const AbstractMetaType* argType = func->arguments().at(argIndex - 1)->type();
+    if (!argType->isContainer() || argType->indirections() > 0 || (argType->isReference() && !argType->isConstant()))
+        return QString();
+    switch (static_cast<const ContainerTypeEntry*>(argType->typeEntry())->type()) {
+        case ContainerTypeEntry::ListContainer:
+        case ContainerTypeEntry::LinkedListContainer:
+        case ContainerTypeEntry::VectorContainer:
+        case ContainerTypeEntry::StackContainer:
+        case ContainerTypeEntry::QueueContainer:
+            break;
+        default:
+            return QString();
+    }
+    return translateTypeForWrapperMethod(argType, func->implementingClass(), ExcludeConst | ExcludeReference).trimmed();
+}
+
+QString CppGenerator::convertedArgumentVariable(const AbstractMetaFunction* func, int argIndex)
+{
+    QString typeName = convertedArgumentType(func, argIndex);
+    if (typeName.isEmpty())
+        return QString();
+
+    int argPos = argIndex - 1;
+    for (int i = 1; i < argIndex; ++i) {
+        if (func->argumentRemoved(i))
+            --argPos;
+    }
+    return QString("convertedArgument%1_%2").arg(argPos).arg(typeName.replace(QRegExp("\\W+"), "_"));
+}
+
+QMap<QString, QString> CppGenerator::convertedArgumentVariables(const OverloadData& overloadData)
+{
+    QMap<QString, QString> result;
+    foreach (const AbstractMetaFunction* func, overloadData.overloads()) {
+        for (int argIndex = 1; argIndex <= func->arguments().count(); ++argIndex) {
+            QString convertedArgumentVar = convertedArgumentVariable(func, argIndex);
+            if (!convertedArgumentVar.isEmpty())
+                result[convertedArgumentVar] = convertedArgumentType(func, argIndex);
+        }
+    }
+    return result;
+}
+
+bool CppGenerator::isByteViewArgument(const AbstractMetaFunction* func, int argIndex)
+{
+    if (!useByteViewArguments(func) || argIndex < 1 || argIndex > func->arguments().count()
+        || func->argumentRemoved(argIndex) || !func->conversionRule(TypeSystem::NativeCode, argIndex).isEmpty()
+        || !func->typeReplaced(argIndex).isEmpty()) {
+        return false;
+    }
+
+    const AbstractMetaType* argType = func->arguments().at(argIndex - 1)->type();
+    if (argType->indirections() != 1 || !argType->isConstant() || argType->isReference())
+        return false;
+    QString typeName = argType->typeEntry()->qualifiedCppName();
+    return typeName == "char" || typeName == "signed char" || typeName == "unsigned char" || typeName == "void";
+}
+
+bool CppGenerator::isUtf8StringArgument(const AbstractMetaFunction* func, int argIndex)
+{
+    if (!useUtf8StringArguments(func) || argIndex < 1 || argIndex > func->arguments().count()
+        || func->argumentRemoved(argIndex) || !func->conversionRule(TypeSystem::NativeCode, argIndex).isEmpty()
+        || !func->typeReplaced(argIndex).isEmpty()) {
+        return false;
+    }
+
+    const AbstractMetaType* argType = func->arguments().at(argIndex - 1)->type();
+    QString typeName = argType->typeEntry()->qualifiedCppName();
+    if (typeName == "char")
+        return argType->indirections() == 1 && argType->isConstant() && !argType->isReference();
+    if (typeName == "std::string")
+        return argType->indirections() == 0 && (!argType->isReference() || argType->isConstant());
+    return false;
+}
+
+QString CppGenerator::byteViewSizeExpression(const AbstractMetaFunction* func, int argIndex)
+{
+    if (argIndex < 2 || !func->argumentRemoved(argIndex)
+        || !func->conversionRule(TypeSystem::NativeCode, argIndex).isEmpty()
+        || !isByteViewArgument(func, argIndex - 1)) {
+        return QString();
+    }
+
+    const AbstractMetaType* argType = func->arguments().at(argIndex - 1)->type();
+    if (argType->indirections() > 0 || argType->isReference() || !isNumber(argType->typeEntry()))
+        return QString();
+
+    int viewArgPos = argIndex - 2;
+    for (int i = 1; i < argIndex - 1; ++i) {
+        if (func->argumentRemoved(i))
+            --viewArgPos;
+    }
+    return QString("static_cast<%1>(" CPP_ARG "%2_view.size())").arg(argType->cppSignature()).arg(viewArgPos);
+}
+
 bool CppGenerator::writeParentChildManagement(QTextStream& s, const AbstractMetaFunction* func, int argIndex, bool useHeuristicPolicy)
 {
     const int numArgs = func->arguments().count();
@@ -4116,6 +4843,44 @@ void CppGenerator::writeHashFunction(QTextStream& s, const AbstractMetaClass* me
     s << '}' << endl << endl;
 }
 
+void CppGenerator::writeBufferProtocolFunctions(QTextStream& s, const AbstractMetaClass* metaClass)
+{
+    ErrorCode errorCode(-1);
+    QString baseName = cpythonBaseName(metaClass);
+
+    s << "#if PY_VERSION_HEX >= 0x02060000" << endl;
+    s << "static int " << baseName << "_getbuffer(PyObject* " PYTHON_SELF_VAR ", Py_buffer* view, int flags)" << endl;
+    s << '{' << endl;
+    writeCppSelfDefinition(s, metaClass);
+    s << INDENT << "Shiboken::Buffer::Layout layout;" << endl;
+    s << INDENT << "if (!" << bufferExporterFunction(metaClass) << "(" CPP_SELF_VAR ", &layout)) {" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "if (!PyErr_Occurred())" << endl;
+        {
+            Indentation indent(INDENT);
+            s << INDENT << "PyErr_SetString(PyExc_BufferError, \"" << metaClass->qualifiedCppName();
+            s << " can't export its memory.\");" << endl;
+        }
+        s << INDENT << "return -1;" << endl;
+    }
+    s << INDENT << '}' << endl;
+    s << INDENT << "return Shiboken::Buffer::fillInfo(view, " PYTHON_SELF_VAR ", layout, flags);" << endl;
+    s << '}' << endl << endl;
+
+    s << "static PyBufferProcs " << baseName << "_BufferProcs = {" << endl;
+    s << "#if PY_MAJOR_VERSION < 3" << endl;
+    s << INDENT << "/*bf_getreadbuffer*/    &Shiboken::Buffer::readBufferProc," << endl;
+    s << INDENT << "/*bf_getwritebuffer*/   &Shiboken::Buffer::writeBufferProc," << endl;
+    s << INDENT << "/*bf_getsegcount*/      &Shiboken::Buffer::segmentCountProc," << endl;
+    s << INDENT << "/*bf_getcharbuffer*/    &Shiboken::Buffer::charBufferProc," << endl;
+    s << "#endif" << endl;
+    s << INDENT << "/*bf_getbuffer*/        &" << baseName << "_getbuffer," << endl;
+    s << INDENT << "/*bf_releasebuffer*/    &Shiboken::Buffer::releaseInfo" << endl;
+    s << "};" << endl;
+    s << "#endif" << endl << endl;
+}
+
 void CppGenerator::writeStdListWrapperMethods(QTextStream& s, const AbstractMetaClass* metaClass)
 {
     ErrorCode errorCode(0);
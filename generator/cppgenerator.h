@@ -83,11 +83,72 @@ private:
      *   \param pyArgName Python argument name
      *   \param context the current meta class
      *   \param defaultValue an optional default value to be used instead of the conversion result
+     *   \param useConversionArena temporaries created by the conversion are kept in the call's conversion arena
      */
     void writeArgumentConversion(QTextStream& s, const AbstractMetaType* argType,
                                  const QString& argName, const QString& pyArgName,
                                  const AbstractMetaClass* context = 0,
-                                 const QString& defaultValue = QString());
+                                 const QString& defaultValue = QString(),
+                                 bool useConversionArena = false,
+                                 const QString& conversionIndexVar = QString());
+
+    /**
+     *  Returns true if the argument of type \p argType is a list like container expected by reference,
+     *  which is taken directly from the Python shared lists holding the same container type.
+     */
+    bool isSharedListArgument(const AbstractMetaType* argType);
+
+    /**
+     *  Returns true if the conversion of the argument at \p argIndex (starting at 1)
+     *  may create a temporary C++ object that must be kept in the conversion arena
+     *  of the wrapper, i.e. a value type argument expected as a pointer or non-const
+     *  reference whose ownership is not changed by the call. Arguments that may outlive
+     *  the call, because the function may return or retain them, are left out; for
+     *  pointers this means only const methods use the arena.
+     */
+    bool argumentUsesConversionArena(const AbstractMetaFunction* func, int argIndex);
+
+    /**
+     *  Returns the name of the variable where the overload decisor keeps the implicit
+     *  conversion matched for the argument at \p argIndex (starting at 1), so that its
+     *  conversion doesn't check the Python object again, or an empty string if the
+     *  argument type has no generated implicit conversions.
+     */
+    QString implicitConversionIndexVariable(const AbstractMetaFunction* func, int argIndex);
+    /// Returns the names of the implicit conversion index variables used by the overloads.
+    QStringList implicitConversionIndexVariables(const OverloadData& overloadData);
+
+    /**
+     *  Returns the C++ type of the list-like container argument at \p argIndex (starting at 1),
+     *  passed by value or const reference, whose items are checked and converted in a single
+     *  walk by the overload decisor, or an empty string if the argument isn't one.
+     */
+    QString convertedArgumentType(const AbstractMetaFunction* func, int argIndex);
+    /**
+     *  Returns the name of the Shiboken::ConvertedArgument variable that keeps the container
+     *  converted by the overload decisor for the argument at \p argIndex, or an empty string.
+     */
+    QString convertedArgumentVariable(const AbstractMetaFunction* func, int argIndex);
+    /// Returns the container types of the converted argument variables used by the overloads, by name.
+    QMap<QString, QString> convertedArgumentVariables(const OverloadData& overloadData);
+
+    /**
+     *  Returns true if the argument at \p argIndex (starting at 1) is a const pointer to
+     *  char or void of a function listed in the "byte-view-arguments" option, which reads
+     *  the bytes of Python strings and buffers through a Shiboken::Buffer::ByteView.
+     */
+    bool isByteViewArgument(const AbstractMetaFunction* func, int argIndex);
+    /**
+     *  Returns the expression that passes the size of the byte view preceding the removed
+     *  numeric argument at \p argIndex, or an empty string if the argument isn't one.
+     */
+    QString byteViewSizeExpression(const AbstractMetaFunction* func, int argIndex);
+    /**
+     *  Returns true if the argument at \p argIndex (starting at 1) is a const char* or a
+     *  std::string of a function listed in the "utf8-string-arguments" option, which also
+     *  accepts unicode objects, converted by Shiboken::String::toUtf8.
+     */
+    bool isUtf8StringArgument(const AbstractMetaFunction* func, int argIndex);
 
     /**
      *  Returns the AbstractMetaType for a function argument.
@@ -107,7 +168,9 @@ private:
                                         const QString& pyIn,
                                         const QString& cppOut,
                                         const AbstractMetaClass* context = 0,
-                                        const QString& defaultValue = QString());
+                                        const QString& defaultValue = QString(),
+                                        bool useConversionArena = false,
+                                        const QString& conversionIndexVar = QString());
 
     /// Writes the conversion rule for arguments of regular and virtual methods.
     void writeConversionRule(QTextStream& s, const AbstractMetaFunction* func, TypeSystem::Language language);
@@ -145,6 +208,34 @@ private:
     /// Returns a string containing the name of an argument for the given function and argument index.
     QString argumentNameFromIndex(const AbstractMetaFunction* func, int argIndex, const AbstractMetaClass** wrappedClass);
     void writeMethodCall(QTextStream& s, const AbstractMetaFunction* func, int maxArgs = 0);
+    /**
+     *  Returns true if the value type object returned by \p func can be constructed on the heap
+     *  straight from the returned temporary and handed to its Python wrapper, instead of being
+     *  stored in a local variable and copied again by the converter.
+     */
+    bool canWrapReturnValueWithoutCopy(const AbstractMetaFunction* func);
+    /**
+     *  Returns true if the non-const map returned by value by \p func is handed to Python as a lazy
+     *  mapping proxy, which converts its items on access, instead of a new dictionary.
+     */
+    bool canReturnLazyMap(const AbstractMetaFunction* func);
+    /**
+     *  Returns true if the non-const list returned by value by \p func is handed to Python as a sequence
+     *  view, which converts its items on access, instead of a new list.
+     */
+    bool canReturnSequenceView(const AbstractMetaFunction* func);
+    /**
+     *  Returns true if the non-const vector of numbers returned by value by \p func is handed to Python as
+     *  an array exporting its memory to buffer and array consumers, instead of a new list.
+     */
+    bool canReturnArray(const AbstractMetaFunction* func);
+    /**
+     *  Returns true if the C string or std::string returned by \p func is converted through
+     *  the cache of short strings, which gives the same Python string for repeated contents.
+     */
+    bool canReturnCachedString(const AbstractMetaFunction* func);
+    /// Returns true if the return value of \p func is not converted by type system rules or injected code.
+    bool hasDefaultReturnValueConversion(const AbstractMetaFunction* func);
 
     void writeClassRegister(QTextStream& s, const AbstractMetaClass* metaClass);
     void writeClassDefinition(QTextStream& s, const AbstractMetaClass* metaClass);
@@ -165,6 +256,25 @@ private:
     void writeTpClearFunction(QTextStream& s, const AbstractMetaClass* metaClass);
 
     void writeCopyFunction(QTextStream& s, const AbstractMetaClass *metaClass);
+    /// Writes __deepcopy__ and the copyList static method, which use the C++ copy constructor, unless the class has them.
+    void writeDeepCopyFunctions(QTextStream& s, const AbstractMetaClass* metaClass);
+    /// Writes __reduce__, __setstate__ and the packList and unpackList static methods of trivially copyable types.
+    void writePickleFunctions(QTextStream& s, const AbstractMetaClass* metaClass);
+    /**
+     *  Returns the numeric getters of \p metaClass, listed in the "array-getters" option, that
+     *  get a static method reading their values for a whole sequence of objects into an array.
+     */
+    AbstractMetaFunctionList arrayGetters(const AbstractMetaClass* metaClass);
+    /// Writes the static method that reads the values of the getter \p func into an array.
+    void writeArrayGetterFunction(QTextStream& s, const AbstractMetaClass* metaClass, const AbstractMetaFunction* func);
+    /**
+     *  Returns the constructor of \p metaClass used to build objects from buffers of numbers, the
+     *  one with most arguments, preferring floating point ones, among those taking only numbers,
+     *  or 0 if the class doesn't get the fromBuffers static method.
+     */
+    const AbstractMetaFunction* bufferConstructor(const AbstractMetaClass* metaClass);
+    /// Writes the fromBuffers static method, which builds a sequence of objects with \p ctor.
+    void writeFromBuffersFunction(QTextStream& s, const AbstractMetaClass* metaClass, const AbstractMetaFunction* ctor);
 
     void writeGetterFunction(QTextStream& s, const AbstractMetaField* metaField);
     void writeSetterFunction(QTextStream& s, const AbstractMetaField* metaField);
@@ -224,6 +334,9 @@ private:
 
     void writeHashFunction(QTextStream& s, const AbstractMetaClass* metaClass);
 
+    /// Writes the buffer protocol functions of a class listed in the "buffer-exporters" option.
+    void writeBufferProtocolFunctions(QTextStream& s, const AbstractMetaClass* metaClass);
+
     /// Write default implementations for sequence protocol
     void writeStdListWrapperMethods(QTextStream& s, const AbstractMetaClass* metaClass);
     /// Helper function for writeStdListWrapperMethods.
@@ -269,6 +269,10 @@ void HeaderGenerator::writeTypeConverterDecl(QTextStream& s, const TypeEntry* ty
     if (isValueTypeWithImplConversions || hasCustomConversion) {
         s << INDENT << "static " << typeName << " toCpp(PyObject* pyobj);" << endl;
         s << INDENT << "static bool isConvertible(PyObject* pyobj);" << endl;
+        if (!hasCustomConversion) {
+            s << INDENT << "static int implicitConversionIndex(PyObject* pyobj);" << endl;
+            s << INDENT << "static " << typeName << " toCpp(PyObject* pyobj, int conversionIndex);" << endl;
+        }
         if (hasCustomConversion) {
             s << INDENT << "static bool checkType(PyObject* pyobj);" << endl;
             s << INDENT << "static inline PyObject* toPython(void* cppObj) { return toPython(*reinterpret_cast< "
@@ -562,83 +566,92 @@ void HeaderGenerator::writeTypeConverterImpl(QTextStream& s, const TypeEntry* ty
 
     const QString typeName = "::" + type->qualifiedCppName();
 
-    // Write Converter<T>::isConvertible
-    s << "inline bool Shiboken::Converter< " << typeName << " >::isConvertible(PyObject* pyobj)" << endl;
+    // Write Converter<T>::implicitConversionIndex, which returns 0 for the type itself,
+    // the position of the first matching implicit conversion, starting at 1, the one
+    // after the last for the external conversions, or -1 if nothing matches.
+    s << "inline int Shiboken::Converter< " << typeName << " >::implicitConversionIndex(PyObject* pyobj)" << endl;
     s << '{' << endl;
-
-    if (type->isValue()) {
-        s << INDENT << "if (ValueTypeConverter< " << typeName << " >::isConvertible(pyobj))" << endl;
+    s << INDENT << "if (PyObject_TypeCheck(pyobj, SbkType< " << typeName << " >()))" << endl;
+    {
         Indentation indent(INDENT);
-        s << INDENT << "return true;" << endl;
+        s << INDENT << "return 0;" << endl;
     }
-
-
-    s << INDENT << "SbkObjectType* shiboType = reinterpret_cast<SbkObjectType*>(SbkType< ";
-    s << typeName << " >());" << endl;
-    s << INDENT << "return ";
-    bool isFirst = true;
+    int conversionIndex = 0;
     foreach (const AbstractMetaFunction* ctor, implicitConvs) {
-        Indentation indent(INDENT);
-        if (isFirst)
-            isFirst = false;
-        else
-            s << endl << INDENT << " || ";
+        ++conversionIndex;
+        if (ctor->isModifiedRemoved())
+            continue;
+        s << INDENT << "if (";
         if (ctor->isConversionOperator())
             s << cpythonCheckFunction(ctor->ownerClass()->typeEntry());
         else
             s << cpythonCheckFunction(ctor->arguments().first()->type());
-        s << "(pyobj)";
+        s << "(pyobj))" << endl;
+        Indentation indent(INDENT);
+        s << INDENT << "return " << conversionIndex << ';' << endl;
     }
-    s << endl;
+    s << INDENT << "if (ObjectType::isExternalConvertible(reinterpret_cast<SbkObjectType*>(SbkType< ";
+    s << typeName << " >()), pyobj))" << endl;
     {
         Indentation indent(INDENT);
-        s << INDENT << " || (ObjectType::isExternalConvertible(shiboType, pyobj));" << endl;
+        s << INDENT << "return " << (conversionIndex + 1) << ';' << endl;
     }
+    s << INDENT << "return -1;" << endl;
+    s << '}' << endl << endl;
+
+    // Write Converter<T>::isConvertible
+    s << "inline bool Shiboken::Converter< " << typeName << " >::isConvertible(PyObject* pyobj)" << endl;
+    s << '{' << endl;
+    s << INDENT << "return implicitConversionIndex(pyobj) >= 0;" << endl;
     s << '}' << endl << endl;
 
     // Write Converter<T>::toCpp function
     s << "inline " << typeName << " Shiboken::Converter< " << typeName << " >::toCpp(PyObject* pyobj)" << endl;
     s << '{' << endl;
+    s << INDENT << "return toCpp(pyobj, implicitConversionIndex(pyobj));" << endl;
+    s << '}' << endl << endl;
 
-    s << INDENT << "if (PyObject_TypeCheck(pyobj, SbkType< " << typeName << " >()))" << endl;
+    // Write Converter<T>::toCpp function that uses the conversion already found
+    // by the overload decisor, or looks for it when the index is negative.
+    s << "inline " << typeName << " Shiboken::Converter< " << typeName << " >::toCpp(PyObject* pyobj, int conversionIndex)" << endl;
+    s << '{' << endl;
+    s << INDENT << "if (conversionIndex < 0)" << endl;
     {
         Indentation indent(INDENT);
-        s << INDENT << "return *" << cpythonWrapperCPtr(type, "pyobj") << ';' << endl;
+        s << INDENT << "conversionIndex = implicitConversionIndex(pyobj);" << endl;
     }
-
-    foreach (const AbstractMetaFunction* ctor, implicitConvs) {
-        if (ctor->isModifiedRemoved())
-            continue;
-
-        s << INDENT << "else ";
-
-        QString typeCheck;
-        QString toCppConv;
-        QTextStream tcc(&toCppConv);
-        if (ctor->isConversionOperator()) {
-            const AbstractMetaClass* metaClass = ctor->ownerClass();
-            typeCheck = cpythonCheckFunction(metaClass->typeEntry());
-            writeToCppConversion(tcc, metaClass, "pyobj");
-        } else {
-            const AbstractMetaType* argType = ctor->arguments().first()->type();
-            typeCheck = cpythonCheckFunction(argType);
-            writeToCppConversion(tcc, argType, 0, "pyobj");
+    s << INDENT << "switch (conversionIndex) {" << endl;
+    {
+        Indentation indent(INDENT);
+        s << INDENT << "case 0:" << endl;
+        {
+            Indentation indent(INDENT);
+            s << INDENT << "return *" << cpythonWrapperCPtr(type, "pyobj") << ';' << endl;
         }
+        conversionIndex = 0;
+        foreach (const AbstractMetaFunction* ctor, implicitConvs) {
+            ++conversionIndex;
+            if (ctor->isModifiedRemoved())
+                continue;
 
-        s << "if (" << typeCheck << "(pyobj))" << endl;
-        {
+            QString toCppConv;
+            QTextStream tcc(&toCppConv);
+            if (ctor->isConversionOperator())
+                writeToCppConversion(tcc, ctor->ownerClass(), "pyobj");
+            else
+                writeToCppConversion(tcc, ctor->arguments().first()->type(), 0, "pyobj");
+
+            s << INDENT << "case " << conversionIndex << ':' << endl;
             Indentation indent(INDENT);
             s << INDENT << "return " << type->name() << '(' << toCppConv << ");" << endl;
         }
-    }
-
-    {
-        s << INDENT << "else" << endl;
+        s << INDENT << "default:" << endl;
         {
             Indentation indent(INDENT);
             s << INDENT << "return Shiboken::ValueTypeConverter< " << typeName << " >::toCpp(pyobj);" << endl;
         }
     }
+    s << INDENT << '}' << endl;
     s << '}' << endl << endl;
 }
 
@@ -38,6 +38,19 @@
 #define ENABLE_PYSIDE_EXTENSIONS "enable-pyside-extensions"
 #define DISABLE_VERBOSE_ERROR_MESSAGES "disable-verbose-error-messages"
 #define USE_ISNULL_AS_NB_NONZERO "use-isnull-as-nb_nonzero"
+#define INLINE_VALUE_TYPES "inline-value-types"
+#define WRAPPER_ONLY_FOR_SUBCLASSES "cpp-wrapper-only-for-subclasses"
+#define LAZY_MAP_RETURNS "lazy-map-returns"
+#define SEQUENCE_VIEW_RETURNS "sequence-view-returns"
+#define BUFFER_EXPORTERS "buffer-exporters"
+#define ARRAY_RETURNS "array-returns"
+#define BYTE_VIEW_ARGUMENTS "byte-view-arguments"
+#define CACHED_STRING_RETURNS "cached-string-returns"
+#define TRIVIALLY_COPYABLE_TYPES "trivially-copyable-types"
+#define DEEP_COPY_TYPES "deep-copy-types"
+#define ARRAY_GETTERS "array-getters"
+#define BUFFER_CONSTRUCTIBLE_TYPES "buffer-constructible-types"
+#define UTF8_STRING_ARGUMENTS "utf8-string-arguments"
 
 //static void dumpFunction(AbstractMetaFunctionList lst);
 static QString baseConversionString(QString typeName);
@@ -1860,9 +1873,34 @@ QMap<QString, QString> ShibokenGenerator::options() const
     opts.insert(ENABLE_PYSIDE_EXTENSIONS, "Enable PySide extensions, such as support for signal/slots, use this if you are creating a binding for a Qt-based library.");
     opts.insert(DISABLE_VERBOSE_ERROR_MESSAGES, "Disable verbose error messages. Turn the python code hard to debug but safe few kB on the generated bindings.");
     opts.insert(USE_ISNULL_AS_NB_NONZERO, "If a class have an isNull()const method, it will be used to compute the value of boolean casts");
+    opts.insert(INLINE_VALUE_TYPES, "Comma separated list of value types whose C++ objects will be stored inside their Python wrappers.");
+    opts.insert(WRAPPER_ONLY_FOR_SUBCLASSES, "Comma separated list of classes whose C++ wrapper will only be instantiated for Python subclasses.");
+    opts.insert(LAZY_MAP_RETURNS, "Comma separated list of functions (e.g. Class::method) whose returned maps are converted lazily.");
+    opts.insert(SEQUENCE_VIEW_RETURNS, "Comma separated list of functions (e.g. Class::method) whose returned lists are converted lazily.");
+    opts.insert(ARRAY_RETURNS, "Comma separated list of functions (e.g. Class::method) whose returned vectors of numbers are exported as arrays.");
+    opts.insert(BUFFER_EXPORTERS, "Comma separated list of Class:function pairs, the function describes the memory exported by Class through the buffer protocol.");
+    opts.insert(BYTE_VIEW_ARGUMENTS, "Comma separated list of functions (e.g. Class::method) whose const char* and const void* arguments take the bytes of Python strings and buffers without copies.");
+    opts.insert(CACHED_STRING_RETURNS, "Comma separated list of functions (e.g. Class::method) or classes whose returned const char* and std::string values reuse cached Python strings for repeated short contents.");
+    opts.insert(TRIVIALLY_COPYABLE_TYPES, "Comma separated list of value types whose C++ objects are fully described by the bytes of their memory, which are used to pickle them. The pickled data is raw memory, only valid for the same build on a platform with the same ABI and byte order, so it is not suited to data stored on disk or sent to other machines.");
+    opts.insert(DEEP_COPY_TYPES, "Comma separated list of value types that get a __deepcopy__ and a copyList static method using the C++ copy constructor.");
+    opts.insert(ARRAY_GETTERS, "Comma separated list of getters (e.g. Class::method) or classes whose numeric getters also read the values of a whole sequence of objects into an array.");
+    opts.insert(BUFFER_CONSTRUCTIBLE_TYPES, "Comma separated list of value types constructed from numbers that can also be built in bulk from buffers of numbers.");
+    opts.insert(UTF8_STRING_ARGUMENTS, "Comma separated list of functions (e.g. Class::method) or classes whose const char* and std::string arguments also accept unicode objects, converted to UTF-8.");
     return opts;
 }
 
+/// Returns the comma separated values of the generator option \p option.
+static QSet<QString> optionValueSet(const QMap<QString, QString>& args, const char* option)
+{
+    QSet<QString> values;
+    foreach (QString value, args.value(option).split(',', QString::SkipEmptyParts)) {
+        value = value.trimmed();
+        if (!value.isEmpty())
+            values << value;
+    }
+    return values;
+}
+
 bool ShibokenGenerator::doSetup(const QMap<QString, QString>& args)
 {
     m_useCtorHeuristic = args.contains(PARENT_CTOR_HEURISTIC);
@@ -1871,6 +1909,26 @@ bool ShibokenGenerator::doSetup(const QMap<QString, QString>& args)
     m_verboseErrorMessagesDisabled = args.contains(DISABLE_VERBOSE_ERROR_MESSAGES);
     m_useIsNullAsNbNonZero = args.contains(USE_ISNULL_AS_NB_NONZERO);
     m_avoidProtectedHack = args.contains(AVOID_PROTECTED_HACK);
+    m_inlineValueTypes = optionValueSet(args, INLINE_VALUE_TYPES);
+    m_wrapperOnlyForSubclasses = optionValueSet(args, WRAPPER_ONLY_FOR_SUBCLASSES);
+    m_lazyMapReturns = optionValueSet(args, LAZY_MAP_RETURNS);
+    m_sequenceViewReturns = optionValueSet(args, SEQUENCE_VIEW_RETURNS);
+    m_arrayReturns = optionValueSet(args, ARRAY_RETURNS);
+    m_byteViewArguments = optionValueSet(args, BYTE_VIEW_ARGUMENTS);
+    m_cachedStringReturns = optionValueSet(args, CACHED_STRING_RETURNS);
+    m_triviallyCopyableTypes = optionValueSet(args, TRIVIALLY_COPYABLE_TYPES);
+    m_deepCopyTypes = optionValueSet(args, DEEP_COPY_TYPES);
+    m_arrayGetters = optionValueSet(args, ARRAY_GETTERS);
+    m_bufferConstructibleTypes = optionValueSet(args, BUFFER_CONSTRUCTIBLE_TYPES);
+    m_utf8StringArguments = optionValueSet(args, UTF8_STRING_ARGUMENTS);
+    foreach (QString exporter, optionValueSet(args, BUFFER_EXPORTERS)) {
+        int separator = exporter.lastIndexOf(':');
+        if (separator < 1 || exporter.at(separator - 1) == ':') {
+            ReportHandler::warning(QString("Invalid buffer exporter '%1', expected Class:function.").arg(exporter));
+            continue;
+        }
+        m_bufferExporters[exporter.left(separator).trimmed()] = exporter.mid(separator + 1).trimmed();
+    }
     return true;
 }
 
@@ -1899,6 +1957,105 @@ bool ShibokenGenerator::avoidProtectedHack() const
     return m_avoidProtectedHack;
 }
 
+bool ShibokenGenerator::useInlineStorage(const AbstractMetaClass* metaClass) const
+{
+    return metaClass->typeEntry()->isValue()
+           && m_inlineValueTypes.contains(metaClass->qualifiedCppName())
+           && !metaClass->isAbstract()
+           && !metaClass->hasPrivateDestructor()
+           && !shouldGenerateCppWrapper(metaClass);
+}
+
+bool ShibokenGenerator::isTriviallyCopyable(const AbstractMetaClass* metaClass) const
+{
+    return metaClass->typeEntry()->isValue()
+           && m_triviallyCopyableTypes.contains(metaClass->qualifiedCppName())
+           && !metaClass->isAbstract()
+           && !metaClass->hasPrivateDestructor()
+           && metaClass->baseClassNames().size() <= 1
+           && !shouldGenerateCppWrapper(metaClass);
+}
+
+bool ShibokenGenerator::useDeepCopy(const AbstractMetaClass* metaClass) const
+{
+    return metaClass->typeEntry()->isValue()
+           && m_deepCopyTypes.contains(metaClass->qualifiedCppName())
+           && !metaClass->isAbstract()
+           && !metaClass->hasPrivateDestructor();
+}
+
+bool ShibokenGenerator::useBufferConstructor(const AbstractMetaClass* metaClass) const
+{
+    return metaClass->typeEntry()->isValue()
+           && m_bufferConstructibleTypes.contains(metaClass->qualifiedCppName())
+           && !metaClass->isAbstract();
+}
+
+bool ShibokenGenerator::useCppWrapperOnlyForSubclasses(const AbstractMetaClass* metaClass) const
+{
+    return m_wrapperOnlyForSubclasses.contains(metaClass->qualifiedCppName())
+           && shouldGenerateCppWrapper(metaClass)
+           && !metaClass->isAbstract()
+           && metaClass->hasVirtualDestructor()
+           && !(avoidProtectedHack() && (metaClass->hasProtectedMembers() || metaClass->hasProtectedDestructor()))
+           && !(usePySideExtensions() && metaClass->isQObject());
+}
+
+static bool functionListContains(const QSet<QString>& functions, const AbstractMetaFunction* func)
+{
+    if (functions.isEmpty())
+        return false;
+    if (!func->ownerClass())
+        return functions.contains(func->name());
+    return functions.contains(func->ownerClass()->qualifiedCppName() + "::" + func->name())
+           || functions.contains(func->implementingClass()->qualifiedCppName() + "::" + func->name());
+}
+
+bool ShibokenGenerator::useLazyMapReturn(const AbstractMetaFunction* func) const
+{
+    return functionListContains(m_lazyMapReturns, func);
+}
+
+bool ShibokenGenerator::useSequenceViewReturn(const AbstractMetaFunction* func) const
+{
+    return functionListContains(m_sequenceViewReturns, func);
+}
+
+bool ShibokenGenerator::useArrayReturn(const AbstractMetaFunction* func) const
+{
+    return functionListContains(m_arrayReturns, func);
+}
+
+bool ShibokenGenerator::useByteViewArguments(const AbstractMetaFunction* func) const
+{
+    return functionListContains(m_byteViewArguments, func);
+}
+
+bool ShibokenGenerator::useCachedStringReturn(const AbstractMetaFunction* func) const
+{
+    return functionListContains(m_cachedStringReturns, func)
+           || (func->ownerClass() && m_cachedStringReturns.contains(func->ownerClass()->qualifiedCppName()));
+}
+
+bool ShibokenGenerator::useUtf8StringArguments(const AbstractMetaFunction* func) const
+{
+    return functionListContains(m_utf8StringArguments, func)
+           || (func->ownerClass() && m_utf8StringArguments.contains(func->ownerClass()->qualifiedCppName()));
+}
+
+bool ShibokenGenerator::useArrayGetter(const AbstractMetaClass* metaClass, const AbstractMetaFunction* func) const
+{
+    return m_arrayGetters.contains(metaClass->qualifiedCppName() + "::" + func->name())
+           || m_arrayGetters.contains(metaClass->qualifiedCppName());
+}
+
+QString ShibokenGenerator::bufferExporterFunction(const AbstractMetaClass* metaClass) const
+{
+    if (metaClass->isNamespace())
+        return QString();
+    return m_bufferExporters.value(metaClass->qualifiedCppName());
+}
+
 QString ShibokenGenerator::cppApiVariableName(const QString& moduleName) const
 {
     QString result = moduleName.isEmpty() ? ShibokenGenerator::packageName() : moduleName;
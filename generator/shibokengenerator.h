@@ -25,6 +25,7 @@
 #define SHIBOKENGENERATOR_H
 
 #define CONV_RULE_OUT_VAR_SUFFIX  "_out"
+#define CONVERSION_ARENA_VAR      "conversionArena"
 #define CPP_ARG                   "cppArg"
 #define CPP_ARG0                  CPP_ARG"0"
 #define CPP_RETURN_VAR            "cppResult"
@@ -384,6 +385,55 @@ public:
     bool useIsNullAsNbNonZero() const;
     /// Returns true if the generated code should use the "#define protected public" hack.
     bool avoidProtectedHack() const;
+    /**
+     *  Returns true if the C++ objects of the value type \p metaClass are constructed inside
+     *  their Python wrappers' memory. The type must be listed in the "inline-value-types"
+     *  option, and must not be abstract, have a private destructor or need a C++ wrapper.
+     */
+    bool useInlineStorage(const AbstractMetaClass* metaClass) const;
+    /**
+     *  Returns true if the C++ objects of the value type \p metaClass can be saved and restored
+     *  as the bytes of their memory. The type must be listed in the "trivially-copyable-types"
+     *  option, and must not be abstract, have a private destructor, multiple base classes or
+     *  need a C++ wrapper.
+     */
+    bool isTriviallyCopyable(const AbstractMetaClass* metaClass) const;
+    /**
+     *  Returns true if the value type \p metaClass is listed in the "deep-copy-types" option,
+     *  and is not abstract nor has a private destructor.
+     */
+    bool useDeepCopy(const AbstractMetaClass* metaClass) const;
+    /**
+     *  Returns true if the value type \p metaClass is listed in the "buffer-constructible-types"
+     *  option and is not abstract.
+     */
+    bool useBufferConstructor(const AbstractMetaClass* metaClass) const;
+    /**
+     *  Returns true if the generated constructor of \p metaClass creates its C++ wrapper only
+     *  for Python subclasses, and the plain C++ class when the exact bound type is instantiated.
+     *  The class must be listed in the "cpp-wrapper-only-for-subclasses" option, be concrete,
+     *  have a virtual destructor and must not need the wrapper to reach protected members.
+     */
+    bool useCppWrapperOnlyForSubclasses(const AbstractMetaClass* metaClass) const;
+    /// Returns true if \p func is listed in the "lazy-map-returns" option.
+    bool useLazyMapReturn(const AbstractMetaFunction* func) const;
+    /// Returns true if \p func is listed in the "sequence-view-returns" option.
+    bool useSequenceViewReturn(const AbstractMetaFunction* func) const;
+    /// Returns true if \p func is listed in the "array-returns" option.
+    bool useArrayReturn(const AbstractMetaFunction* func) const;
+    /// Returns true if \p func is listed in the "byte-view-arguments" option.
+    bool useByteViewArguments(const AbstractMetaFunction* func) const;
+    /// Returns true if \p func or its class is listed in the "cached-string-returns" option.
+    bool useCachedStringReturn(const AbstractMetaFunction* func) const;
+    /// Returns true if \p func or its class is listed in the "utf8-string-arguments" option.
+    bool useUtf8StringArguments(const AbstractMetaFunction* func) const;
+    /// Returns true if the getter \p func of \p metaClass, or \p metaClass itself, is listed in the "array-getters" option.
+    bool useArrayGetter(const AbstractMetaClass* metaClass, const AbstractMetaFunction* func) const;
+    /**
+     *  Returns the name of the function describing the memory exported by \p metaClass through
+     *  the buffer protocol, given in the "buffer-exporters" option, or an empty string.
+     */
+    QString bufferExporterFunction(const AbstractMetaClass* metaClass) const;
     QString cppApiVariableName(const QString& moduleName = QString()) const;
     /**
      *  Returns the type index variable name for a given class. If \p alternativeTemplateName is true
@@ -469,6 +519,19 @@ private:
     bool m_verboseErrorMessagesDisabled;
     bool m_useIsNullAsNbNonZero;
     bool m_avoidProtectedHack;
+    QSet<QString> m_inlineValueTypes;
+    QSet<QString> m_wrapperOnlyForSubclasses;
+    QSet<QString> m_lazyMapReturns;
+    QSet<QString> m_sequenceViewReturns;
+    QSet<QString> m_arrayReturns;
+    QSet<QString> m_byteViewArguments;
+    QSet<QString> m_cachedStringReturns;
+    QSet<QString> m_triviallyCopyableTypes;
+    QSet<QString> m_deepCopyTypes;
+    QSet<QString> m_arrayGetters;
+    QSet<QString> m_bufferConstructibleTypes;
+    QSet<QString> m_utf8StringArguments;
+    QHash<QString, QString> m_bufferExporters;
 
     typedef QHash<QString, AbstractMetaType*> AbstractMetaTypeCache;
     AbstractMetaTypeCache m_metaTypeFromStringCache;
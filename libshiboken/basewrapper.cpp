@@ -31,6 +31,11 @@
 #include <cstddef>
 #include <algorithm>
 #include "threadstatesaver.h"
+#include "sbkmapproxy.h"
+#include "sbksequenceview.h"
+#include "sbksharedlist.h"
+#include "sbkarray.h"
+#include "sbkstring.h"
 
 extern "C"
 {
@@ -102,6 +107,16 @@ static PyGetSetDef SbkObjectGetSetList[] = {
     {0} // Sentinel
 };
 
+static PyObject* SbkObject_sizeof(PyObject* self)
+{
+    return PyInt_FromSize_t(Shiboken::Object::sizeOf(reinterpret_cast<SbkObject*>(self)));
+}
+
+static PyMethodDef SbkObjectMethods[] = {
+    {"__sizeof__", (PyCFunction)SbkObject_sizeof, METH_NOARGS, "Size of the wrapper and its C++ object in memory, in bytes."},
+    {0} // Sentinel
+};
+
 static int SbkObject_traverse(PyObject* self, visitproc visit, void* arg)
 {
     SbkObject* sbkSelf = reinterpret_cast<SbkObject*>(self);
@@ -147,7 +162,7 @@ SbkObjectType SbkObject_Type = { { {
     /*tp_weaklistoffset*/   offsetof(SbkObject, weakreflist),
     /*tp_iter*/             0,
     /*tp_iternext*/         0,
-    /*tp_methods*/          0,
+    /*tp_methods*/          SbkObjectMethods,
     /*tp_members*/          0,
     /*tp_getset*/           SbkObjectGetSetList,
     /*tp_base*/             0,
@@ -182,6 +197,14 @@ void SbkDeallocWrapper(PyObject* pyObj)
         if (sbkType->d->is_multicpp) {
             Shiboken::DtorCallerVisitor visitor(sbkObj);
             Shiboken::walkThroughClassHierarchy(pyObj->ob_type, &visitor);
+        } else if (Shiboken::isInlineCppObject(sbkObj, sbkType, sbkObj->d->cptr[0])) {
+            // The C++ object lives in the wrapper memory, it must die before the memory is released.
+            {
+                Shiboken::ThreadStateSaver threadSaver;
+                threadSaver.save();
+                sbkType->d->cpp_inline_dtor(sbkObj->d->cptr[0]);
+            }
+            Shiboken::Object::deallocData(sbkObj, true);
         } else {
             void* cptr = sbkObj->d->cptr[0];
             Shiboken::Object::deallocData(sbkObj, true);
@@ -204,6 +227,9 @@ void SbkDeallocWrapperWithPrivateDtor(PyObject* self)
     Shiboken::Object::deallocData(sbkObj, true);
 }
 
+// Incremented when the external conversions change, to discard the cached decisions.
+static unsigned long externalConversionsGeneration = 0;
+
 void SbkObjectTypeDealloc(PyObject* pyObj)
 {
     SbkObjectType* sbkType = reinterpret_cast<SbkObjectType*>(pyObj);
@@ -217,6 +243,10 @@ void SbkObjectTypeDealloc(PyObject* pyObj)
         }
         free(sbkType->d->original_name);
         sbkType->d->original_name = 0;
+        // The cached decisions are keyed by the target type, whose address may be reused.
+        if (sbkType->d->ext_isconvertible)
+            ++externalConversionsGeneration;
+        delete sbkType->d->ext_conversion_cache;
         delete sbkType->d;
         sbkType->d = 0;
     }
@@ -266,6 +296,8 @@ PyObject* SbkObjectTypeTpNew(PyTypeObject* metatype, PyObject* args, PyObject* k
         d->ext_tocpp = parentType->ext_tocpp;
         d->type_discovery = parentType->type_discovery;
         d->cpp_dtor = parentType->cpp_dtor;
+        d->cpp_inline_dtor = parentType->cpp_inline_dtor;
+        d->cpp_sizeof = parentType->cpp_sizeof;
         d->is_multicpp = 0;
     } else {
         d->mi_offsets = 0;
@@ -275,6 +307,8 @@ PyObject* SbkObjectTypeTpNew(PyTypeObject* metatype, PyObject* args, PyObject* k
         d->ext_tocpp = 0;
         d->type_discovery = 0;
         d->cpp_dtor = 0;
+        d->cpp_inline_dtor = 0;
+        d->cpp_sizeof = 0;
         d->is_multicpp = 1;
     }
     if (bases.size() == 1)
@@ -379,6 +413,13 @@ bool importModule(const char* moduleName, PyTypeObject*** cppApiPtr)
 
 // Wrapper metatype and base type ----------------------------------------------------------
 
+void SizeOfVisitor::visit(SbkObjectType* node)
+{
+    void* cptr = m_pyObj->d->cptr[m_index++];
+    if (cptr && node->d->cpp_sizeof && !isInlineCppObject(m_pyObj, node, cptr))
+        m_size += node->d->cpp_sizeof(cptr);
+}
+
 void DtorCallerVisitor::visit(SbkObjectType* node)
 {
     m_ptrs.push_back(std::make_pair(m_pyObj->d->cptr[m_ptrs.size()], node));
@@ -386,10 +427,22 @@ void DtorCallerVisitor::visit(SbkObjectType* node)
 
 void DtorCallerVisitor::done()
 {
+    // C++ objects living in the wrapper memory must die before it is released.
+    std::list<std::pair<void*, SbkObjectType*> >::iterator it = m_ptrs.begin();
+    while (it != m_ptrs.end()) {
+        if (isInlineCppObject(m_pyObj, it->second, it->first)) {
+            Shiboken::ThreadStateSaver threadSaver;
+            threadSaver.save();
+            it->second->d->cpp_inline_dtor(it->first);
+            it = m_ptrs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
     Shiboken::Object::deallocData(m_pyObj, true);
 
-    std::list<std::pair<void*, SbkObjectType*> >::const_iterator it = m_ptrs.begin();
-    for (; it != m_ptrs.end(); ++it) {
+    for (it = m_ptrs.begin(); it != m_ptrs.end(); ++it) {
         Shiboken::ThreadStateSaver threadSaver;
         threadSaver.save();
         it->second->d->cpp_dtor(it->first);
@@ -398,6 +451,26 @@ void DtorCallerVisitor::done()
 
 namespace Module { void init(); }
 
+static PyObject* clearStringCache(PyObject*)
+{
+    String::clearCache();
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef clearStringCacheDef = { "clearStringCache", (PyCFunction)clearStringCache, METH_NOARGS, 0 };
+
+// The strings cached by Shiboken::String are released by the atexit module, while the
+// interpreter is still able to deallocate them.
+static bool registerStringCacheCleanup()
+{
+    AutoDecRef atexit(PyImport_ImportModule("atexit"));
+    AutoDecRef function(PyCFunction_New(&clearStringCacheDef, 0));
+    if (atexit.isNull() || function.isNull())
+        return false;
+    AutoDecRef result(PyObject_CallMethod(atexit, const_cast<char*>("register"), const_cast<char*>("O"), function.object()));
+    return !result.isNull();
+}
+
 void init()
 {
     static bool shibokenAlreadInitialised = false;
@@ -421,6 +494,24 @@ void init()
     if (PyType_Ready((PyTypeObject *)&SbkObject_Type) < 0)
         Py_FatalError("[libshiboken] Failed to initialise Shiboken.BaseWrapper type.");
 
+    if (PyType_Ready(&SbkMapProxy_Type) < 0)
+        Py_FatalError("[libshiboken] Failed to initialise Shiboken.MapProxy type.");
+
+    if (PyType_Ready(&SbkMapProxyIterator_Type) < 0)
+        Py_FatalError("[libshiboken] Failed to initialise Shiboken.MapProxyIterator type.");
+
+    if (PyType_Ready(&SbkSequenceView_Type) < 0)
+        Py_FatalError("[libshiboken] Failed to initialise Shiboken.SequenceView type.");
+
+    if (PyType_Ready(&SbkSharedList_Type) < 0)
+        Py_FatalError("[libshiboken] Failed to initialise Shiboken.SharedList type.");
+
+    if (PyType_Ready(&SbkArray_Type) < 0)
+        Py_FatalError("[libshiboken] Failed to initialise Shiboken.Array type.");
+
+    if (!registerStringCacheCleanup())
+        Py_FatalError("[libshiboken] Failed to register the release of the string cache.");
+
     shibokenAlreadInitialised = true;
 }
 
@@ -553,11 +644,35 @@ void setExternalCppConversionFunction(SbkObjectType* self, ExtendedToCppFunc fun
 void setExternalIsConvertibleFunction(SbkObjectType* self, ExtendedIsConvertibleFunc func)
 {
     self->d->ext_isconvertible = func;
+    ++externalConversionsGeneration;
 }
 
 bool isExternalConvertible(SbkObjectType* self, PyObject* obj)
 {
-    return self->d->ext_isconvertible && self->d->ext_isconvertible(obj);
+    if (!self->d->ext_isconvertible)
+        return false;
+
+    // Whether a wrapper is accepted by the conversions of other modules depends on its type
+    // alone, unless it is a sequence, whose items could be checked. The decisions are kept
+    // in the wrapper type, to avoid running the check chains of the other modules again.
+    SbkObjectTypePrivate* sourceData = Object::checkType(obj) ? reinterpret_cast<SbkObjectType*>(obj->ob_type)->d : 0;
+    if (!sourceData || PySequence_Check(obj))
+        return self->d->ext_isconvertible(obj);
+
+    if (!sourceData->ext_conversion_cache)
+        sourceData->ext_conversion_cache = new ExternalConversionCache;
+    ExternalConversionCache* cache = sourceData->ext_conversion_cache;
+    if (cache->generation != externalConversionsGeneration) {
+        cache->results.clear();
+        cache->generation = externalConversionsGeneration;
+    }
+
+    std::map<SbkObjectType*, bool>::const_iterator it = cache->results.find(self);
+    if (it != cache->results.end())
+        return it->second;
+    bool result = self->d->ext_isconvertible(obj);
+    cache->results[self] = result;
+    return result;
 }
 
 bool hasCast(SbkObjectType* type)
@@ -619,6 +734,21 @@ void setDestructorFunction(SbkObjectType* self, ObjectDestructor func)
     self->d->cpp_dtor = func;
 }
 
+void setInlineDestructorFunction(SbkObjectType* self, ObjectDestructor func)
+{
+    self->d->cpp_inline_dtor = func;
+}
+
+bool hasInlineStorage(SbkObjectType* self)
+{
+    return self->d->cpp_inline_dtor;
+}
+
+void setCppSizeFunction(SbkObjectType* self, ObjectSizeFunction func)
+{
+    self->d->cpp_sizeof = func;
+}
+
 void initPrivateData(SbkObjectType* self)
 {
     self->d = new SbkObjectTypePrivate;
@@ -874,6 +1004,19 @@ bool setCppPointer(SbkObject* sbkObj, PyTypeObject* desiredType, void* cptr)
     return !alreadyInitialized;
 }
 
+void* inlineStorage(SbkObject* sbkObj, PyTypeObject* desiredType)
+{
+    int idx = 0;
+    if (reinterpret_cast<SbkObjectType*>(sbkObj->ob_type)->d->is_multicpp)
+        idx = getTypeIndexOnHierarchy(sbkObj->ob_type, desiredType);
+
+    if (sbkObj->d->cptr[idx]) {
+        PyErr_SetString(PyExc_RuntimeError, "You can't initialize an object twice!");
+        return 0;
+    }
+    return reinterpret_cast<char*>(sbkObj) + SBK_INLINE_STORAGE_OFFSET;
+}
+
 bool isValid(PyObject* pyObj)
 {
     if (!pyObj || pyObj == Py_None
@@ -1213,6 +1356,49 @@ void clearReferences(SbkObject* self)
     self->d->referredObjects = 0;
 }
 
+// Estimated overhead of the node of a std::map/std::set (color and three links) and of a std::list.
+static const size_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+static const size_t LIST_NODE_OVERHEAD = 2 * sizeof(void*);
+
+size_t sizeOf(SbkObject* self)
+{
+    PyTypeObject* pyType = self->ob_type;
+    SbkObjectType* sbkType = reinterpret_cast<SbkObjectType*>(pyType);
+    int numBases = (sbkType->d && sbkType->d->is_multicpp) ? getNumberOfCppBaseClasses(pyType) : 1;
+
+    // The Python object, which includes any C++ object stored inline, and its private data.
+    size_t size = pyType->tp_basicsize + sizeof(SbkObjectPrivate) + numBases * sizeof(void*);
+
+    // Binding manager entries, one for each registered C++ pointer.
+    if (self->d->validCppObject)
+        size += numBases * 2 * sizeof(void*);
+
+    if (self->d->parentInfo)
+        size += sizeof(ParentInfo) + self->d->parentInfo->children.size() * (TREE_NODE_OVERHEAD + sizeof(SbkObject*));
+
+    if (self->d->referredObjects) {
+        const RefCountMap& refCountMap = *(self->d->referredObjects);
+        size += sizeof(RefCountMap);
+        for (RefCountMap::const_iterator it = refCountMap.begin(); it != refCountMap.end(); ++it) {
+            size += TREE_NODE_OVERHEAD + sizeof(RefCountMap::value_type) + it->first.capacity();
+            size += it->second.size() * (LIST_NODE_OVERHEAD + sizeof(PyObject*));
+        }
+    }
+
+    if (self->d->validCppObject && sbkType->d) {
+        if (sbkType->d->is_multicpp) {
+            SizeOfVisitor visitor(self);
+            walkThroughClassHierarchy(pyType, &visitor);
+            size += visitor.size();
+        } else {
+            void* cptr = self->d->cptr[0];
+            if (cptr && sbkType->d->cpp_sizeof && !isInlineCppObject(self, sbkType, cptr))
+                size += sbkType->d->cpp_sizeof(cptr);
+        }
+    }
+    return size;
+}
+
 } // namespace Object
 
 } // namespace Shiboken
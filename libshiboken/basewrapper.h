@@ -46,6 +46,15 @@ struct LIBSHIBOKEN_API SbkObject
     SbkObjectPrivate* d;
 };
 
+/**
+ *  Offset, from the start of a SbkObject, of the memory where the C++ object is kept
+ *  by types with inline storage (see Shiboken::ObjectType::setInlineDestructorFunction).
+ *  The wrapper type must reserve this memory by setting its tp_basicsize to
+ *  SBK_INLINE_STORAGE_OFFSET + sizeof(T).
+ */
+#define SBK_INLINE_STORAGE_OFFSET \
+        ((sizeof(SbkObject) + sizeof(double) - 1) / sizeof(double) * sizeof(double))
+
 
 /// Dealloc the python object \p pyObj and the C++ object represented by it.
 LIBSHIBOKEN_API void SbkDeallocWrapper(PyObject* pyObj);
@@ -72,6 +81,9 @@ typedef void (*DeleteUserDataFunc)(void*);
 
 typedef void (*ObjectDestructor)(void*);
 
+/// Returns the memory used by the C++ object at the given address, including memory it owns.
+typedef size_t (*ObjectSizeFunction)(void*);
+
 typedef void (*SubTypeInitHook)(SbkObjectType*, PyObject*, PyObject*);
 
 extern LIBSHIBOKEN_API PyTypeObject SbkObjectType_Type;
@@ -106,6 +118,20 @@ void callCppDestructor(void* cptr)
     delete reinterpret_cast<T*>(cptr);
 }
 
+/// Call the destructor of the class T constructed in place at \p cptr, without releasing its memory.
+template<typename T>
+void callCppInlineDestructor(void* cptr)
+{
+    reinterpret_cast<T*>(cptr)->~T();
+}
+
+/// Returns the size of the class T, the default ObjectSizeFunction.
+template<typename T>
+size_t cppObjectSize(void*)
+{
+    return sizeof(T);
+}
+
 /**
  *  Shiboken::importModule is DEPRECATED. Use Shiboken::Module::import() instead.
  */
@@ -165,6 +191,23 @@ LIBSHIBOKEN_API MultipleInheritanceInitFunction getMultipleIheritanceFunction(Sb
 
 LIBSHIBOKEN_API void        setDestructorFunction(SbkObjectType* self, ObjectDestructor func);
 
+/**
+ *  Makes the instances of \p self keep their C++ object inside the wrapper memory, right after
+ *  the SbkObject structure, instead of allocating it on the heap. The C++ object is constructed
+ *  with placement new on the memory returned by Object::inlineStorage(), and destroyed by \p func,
+ *  which must only call the destructor (e.g. callCppInlineDestructor<T>).
+ *  \note Objects stored inline can not have their ownership transferred to C++.
+ */
+LIBSHIBOKEN_API void        setInlineDestructorFunction(SbkObjectType* self, ObjectDestructor func);
+/// Returns true if the instances of \p self keep their C++ object inside the wrapper memory.
+LIBSHIBOKEN_API bool        hasInlineStorage(SbkObjectType* self);
+
+/**
+ *  Sets the function used by Object::sizeOf() to get the memory used by the C++ instances of \p self.
+ *  Types without a size function have their C++ objects ignored by the memory accounting.
+ */
+LIBSHIBOKEN_API void        setCppSizeFunction(SbkObjectType* self, ObjectSizeFunction func);
+
 LIBSHIBOKEN_API void        initPrivateData(SbkObjectType* self);
 
 /**
@@ -289,6 +332,14 @@ LIBSHIBOKEN_API void*       cppPointer(SbkObject* pyObj, PyTypeObject* desiredTy
  */
 LIBSHIBOKEN_API bool        setCppPointer(SbkObject* sbkObj, PyTypeObject* desiredType, void* cptr);
 
+/**
+ *  Returns the memory reserved inside \p sbkObj to construct the C++ object of type \p desiredType,
+ *  which must have inline storage. Returns NULL and sets a Python RuntimeError if the C++ object
+ *  was already set.
+ *  \see ObjectType::setInlineDestructorFunction
+ */
+LIBSHIBOKEN_API void*       inlineStorage(SbkObject* sbkObj, PyTypeObject* desiredType);
+
 /**
  * Returns false and sets a Python RuntimeError if the Python wrapper is not marked as valid.
  */
@@ -383,6 +434,15 @@ LIBSHIBOKEN_API void        keepReference(SbkObject* self, const char* key, PyOb
  */
 LIBSHIBOKEN_API void        removeReference(SbkObject* self, const char* key, PyObject* referredObject);
 
+/**
+ *  Returns the memory used by the wrapper \p self: the Python object, the Shiboken private data
+ *  (C++ pointers, parent and reference information, binding manager entries) and, if still valid,
+ *  the C++ objects as reported by the size functions of their types. Memory used by the binding
+ *  manager containers is an estimate. This is the value returned by the wrappers' __sizeof__.
+ *  \see ObjectType::setCppSizeFunction
+ */
+LIBSHIBOKEN_API size_t      sizeOf(SbkObject* self);
+
 } // namespace Object
 
 } // namespace Shiboken
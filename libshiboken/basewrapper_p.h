@@ -42,6 +42,18 @@ typedef std::map<std::string, std::list<PyObject*> > RefCountMap;
 /// Linked list of SbkBaseWrapper pointers
 typedef std::set<SbkObject*> ChildrenList;
 
+/**
+ * Results of the external "isConvertible" functions of the target types, kept for the
+ * instances of a source wrapper type.
+ */
+struct ExternalConversionCache
+{
+    ExternalConversionCache() : generation(0) {}
+    /// Number of changes to the external conversions, or of deleted target types, when the results were taken.
+    unsigned long generation;
+    std::map<SbkObjectType*, bool> results;
+};
+
 /// Struct used to store information about object parent and children.
 struct ParentInfo
 {
@@ -101,8 +113,14 @@ struct SbkObjectTypePrivate
     ExtendedIsConvertibleFunc ext_isconvertible;
     /// Extended "toCpp" function to be used when a conversion operator is defined in another module.
     ExtendedToCppFunc ext_tocpp;
+    /// External conversion decisions taken for the instances of this type, created on demand.
+    Shiboken::ExternalConversionCache* ext_conversion_cache;
     /// Pointer to a function responsible for deletion of the C++ instance calling the proper destructor.
     ObjectDestructor cpp_dtor;
+    /// Destructor for C++ instances kept inside the wrapper memory, null if the type doesn't use inline storage.
+    ObjectDestructor cpp_inline_dtor;
+    /// Returns the memory used by a C++ instance, null if unknown.
+    ObjectSizeFunction cpp_sizeof;
     /// True if this type holds two or more C++ instances, e.g.: a Python class which inherits from two C++ classes.
     int is_multicpp:1;
     /// True if this type was defined by the user.
@@ -190,6 +208,19 @@ private:
     PyTypeObject* m_desiredType;
 };
 
+/// Sums the memory used by the C++ objects of a multiple inheritance wrapper.
+class SizeOfVisitor : public HierarchyVisitor
+{
+public:
+    SizeOfVisitor(SbkObject* pyObj) : m_pyObj(pyObj), m_index(0), m_size(0) {}
+    void visit(SbkObjectType* node);
+    size_t size() const { return m_size; }
+private:
+    SbkObject* m_pyObj;
+    int m_index;
+    size_t m_size;
+};
+
 class DtorCallerVisitor : public HierarchyVisitor
 {
 public:
@@ -209,6 +240,12 @@ private:
 */
 void walkThroughClassHierarchy(PyTypeObject* currentType, HierarchyVisitor* visitor);
 
+/// Returns true if \p cptr is the C++ object of type \p type kept inside the \p self wrapper memory.
+inline bool isInlineCppObject(SbkObject* self, SbkObjectType* type, void* cptr)
+{
+    return type->d->cpp_inline_dtor && cptr == reinterpret_cast<char*>(self) + SBK_INLINE_STORAGE_OFFSET;
+}
+
 inline int getTypeIndexOnHierarchy(PyTypeObject* baseType, PyTypeObject* desiredType)
 {
     GetIndexVisitor visitor(desiredType);
@@ -280,6 +280,19 @@ std::set<SbkObject*> BindingManager::getAllPyObjects()
     return pyObjects;
 }
 
+MemoryUsageMap BindingManager::memoryUsage()
+{
+    MemoryUsageMap usage;
+    std::set<SbkObject*> pyObjects = getAllPyObjects();
+    std::set<SbkObject*>::const_iterator it = pyObjects.begin();
+    for (; it != pyObjects.end(); ++it) {
+        MemoryUsage& typeUsage = usage[(*it)->ob_type];
+        typeUsage.objects++;
+        typeUsage.bytes += Object::sizeOf(*it);
+    }
+    return usage;
+}
+
 void BindingManager::visitAllPyObjects(ObjectVisitor visitor, void* data)
 {
     WrapperMap copy = m_d->wrapperMapper;
@@ -24,6 +24,7 @@
 #define BINDINGMANAGER_H
 
 #include <Python.h>
+#include <map>
 #include <set>
 #include "shibokenmacros.h"
 
@@ -35,6 +36,15 @@ namespace Shiboken
 
 typedef void (*ObjectVisitor)(SbkObject*, void*);
 
+/// Number of wrappers of a type and the memory they use, in bytes.
+struct MemoryUsage
+{
+    MemoryUsage() : objects(0), bytes(0) {}
+    size_t objects;
+    size_t bytes;
+};
+typedef std::map<PyTypeObject*, MemoryUsage> MemoryUsageMap;
+
 class LIBSHIBOKEN_API BindingManager
 {
 public:
@@ -62,6 +72,12 @@ public:
      */
     void visitAllPyObjects(ObjectVisitor visitor, void* data);
 
+    /**
+     * Returns the number of wrappers registered on binding manager and the memory used by them,
+     * as reported by Object::sizeOf(), aggregated by the exact Python type of the wrappers.
+     */
+    MemoryUsageMap memoryUsage();
+
 private:
     ~BindingManager();
     // disable copy
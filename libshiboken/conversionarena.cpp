@@ -0,0 +1,67 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "conversionarena.h"
+
+namespace Shiboken
+{
+
+static inline size_t alignedSize(size_t size)
+{
+    return (size + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+}
+
+void* ConversionArena::allocate(size_t size)
+{
+    size_t blockSize = alignedSize(sizeof(Entry)) + alignedSize(size);
+    char* block;
+    bool onHeap = m_used + blockSize > BufferSize;
+    if (onHeap) {
+        block = reinterpret_cast<char*>(::operator new(blockSize));
+    } else {
+        block = m_buffer + m_used;
+        m_used += blockSize;
+    }
+
+    Entry* entry = reinterpret_cast<Entry*>(block);
+    entry->previous = m_last;
+    entry->destructor = 0;
+    entry->onHeap = onHeap;
+    m_last = entry;
+    return block + alignedSize(sizeof(Entry));
+}
+
+void ConversionArena::clear()
+{
+    while (m_last) {
+        Entry* entry = m_last;
+        m_last = entry->previous;
+        if (entry->destructor)
+            entry->destructor(reinterpret_cast<char*>(entry) + alignedSize(sizeof(Entry)));
+        if (entry->onHeap)
+            ::operator delete(entry);
+    }
+    m_used = 0;
+}
+
+} // namespace Shiboken
+
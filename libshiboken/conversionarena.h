@@ -0,0 +1,97 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CONVERSIONARENA_H
+#define CONVERSIONARENA_H
+
+#include <Python.h>
+#include <new>
+#include "shibokenmacros.h"
+
+namespace Shiboken
+{
+
+/**
+ * Scratch storage for the temporary C++ objects created while converting the
+ * arguments of a single wrapped call (e.g. the value created by an implicit
+ * conversion when a function expects a pointer or a non-const reference).
+ *
+ * Small objects are placed in a buffer that lives on the stack of the wrapper
+ * function, larger ones fall back to the heap. All objects are destroyed, in
+ * reverse order of creation, when the arena goes out of scope.
+ */
+class LIBSHIBOKEN_API ConversionArena
+{
+public:
+    typedef void (*Destructor)(void*);
+
+    ConversionArena() : m_used(0), m_last(0) {}
+    ~ConversionArena() { clear(); }
+
+    /// Copies \p value into the arena and returns a pointer to the copy.
+    template<typename T>
+    T* create(const T& value)
+    {
+        void* storage = allocate(sizeof(T));
+        T* obj = new (storage) T(value);
+        m_last->destructor = &destroyObject<T>;
+        return obj;
+    }
+
+    /// Returns \p size bytes of uninitialized storage, released when the arena is cleared.
+    char* createBuffer(size_t size) { return reinterpret_cast<char*>(allocate(size)); }
+
+    /// Destroys all the objects created by this arena.
+    void clear();
+
+private:
+    enum { BufferSize = 256 };
+
+    struct Entry
+    {
+        Entry* previous;
+        Destructor destructor;
+        bool onHeap;
+    };
+
+    template<typename T>
+    static void destroyObject(void* obj) { reinterpret_cast<T*>(obj)->~T(); }
+
+    void* allocate(size_t size);
+
+    union {
+        char m_buffer[BufferSize];
+        double m_alignDouble;
+        void* m_alignPointer;
+        PY_LONG_LONG m_alignLongLong;
+    };
+    size_t m_used;
+    Entry* m_last;
+
+    ConversionArena(const ConversionArena&);
+    ConversionArena& operator=(const ConversionArena&);
+};
+
+} // namespace Shiboken
+
+#endif // CONVERSIONARENA_H
+
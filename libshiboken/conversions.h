@@ -24,23 +24,36 @@
 #define CONVERSIONS_H
 
 #include <Python.h>
+#include <algorithm>
 #include <limits>
+#include <map>
 #include <memory>
+#include <new>
+#include <set>
+#include <string>
 #include <typeinfo>
+#include <utility>
+#include <vector>
 
 #include "sbkenum.h"
 #include "basewrapper.h"
 #include "bindingmanager.h"
 #include "sbkdbg.h"
+#include "conversionarena.h"
+#include "sbksharedlist.h"
+#include "threadstatesaver.h"
 
 // When the user adds a function with an argument unknown for the typesystem, the generator writes type checks as
 // TYPENAME_Check, so this macro allows users to add PyObject arguments to their added functions.
 #define PyObject_Check(X) true
 #include "autodecref.h"
+#include "helper.h"
 
 // Note: if there wasn't for the old-style classes, only a PyNumber_Check would suffice.
+// Exact ints and floats, the usual arguments, are accepted before any slot lookup.
 #define SbkNumber_Check(X) \
-        (PyNumber_Check(X) && (!PyInstance_Check(X) || PyObject_HasAttrString(X, "__trunc__")))
+        (PyInt_CheckExact(X) || PyFloat_CheckExact(X) \
+         || (PyNumber_Check(X) && (!PyInstance_Check(X) || Shiboken::hasTruncMethod(X))))
 
 namespace Shiboken
 {
@@ -84,6 +97,25 @@ inline PyObject* createWrapper(const T* cppobj, bool hasOwnership = false, bool
                               const_cast<T*>(cppobj), hasOwnership, isExactType, typeName);
 }
 
+/**
+ * Creates a wrapper for a copy of \p cppobj, constructed in the wrapper's own memory.
+ * The Python type of T must have inline storage, see ObjectType::setInlineDestructorFunction.
+ * Returns 0 with a Python error set if the wrapper could not be allocated.
+ */
+template<typename T>
+inline PyObject* createInlineWrapper(const T& cppobj)
+{
+    PyTypeObject* type = SbkType<T>();
+    SbkObject* self = reinterpret_cast<SbkObject*>(SbkObjectTpNew(type, 0, 0));
+    if (!self)
+        return 0;
+    T* cptr = new (Object::inlineStorage(self, type)) T(cppobj);
+    Object::setCppPointer(self, type, cptr);
+    Object::setValidCpp(self, true);
+    BindingManager::instance().registerWrapper(self, cptr);
+    return reinterpret_cast<PyObject*>(self);
+}
+
 // Base Conversions ----------------------------------------------------------
 // The basic converter must be empty to avoid object types being converted by value.
 template <typename T> struct Converter {};
@@ -126,6 +158,21 @@ struct Converter<T*>
         assert(false);
         return 0;
     }
+
+    // Same as toCpp(PyObject*), but the temporary object created by an implicit
+    // conversion is kept in the caller's arena instead of being leaked.
+    static T* toCpp(PyObject* pyobj, ConversionArena& arena)
+    {
+        if (PyObject_TypeCheck(pyobj, SbkType<T>()))
+            return (T*) Object::cppPointer(reinterpret_cast<SbkObject*>(pyobj), SbkType<T>());
+        else if (Converter<T>::isConvertible(pyobj))
+            return arena.create<T>(Converter<T>::toCpp(pyobj));
+        else if (pyobj == Py_None)
+            return 0;
+
+        assert(false);
+        return 0;
+    }
 };
 template <typename T> struct Converter<const T*> : Converter<T*> {};
 
@@ -137,6 +184,7 @@ struct Converter<T&>
     static inline bool isConvertible(PyObject* pyObj) { return Converter<T>::isConvertible(pyObj); }
     static inline PyObject* toPython(const T& cppobj) { return Converter<T*>::toPython(&cppobj); }
     static inline T& toCpp(PyObject* pyobj) { return *Converter<T*>::toCpp(pyobj); }
+    static inline T& toCpp(PyObject* pyobj, ConversionArena& arena) { return *Converter<T*>::toCpp(pyobj, arena); }
 };
 
 // Void pointer conversions.
@@ -175,6 +223,8 @@ struct ValueTypeConverter
     static inline PyObject* toPython(void* cppobj) { return toPython(*reinterpret_cast<T*>(cppobj)); }
     static inline PyObject* toPython(const T& cppobj)
     {
+        if (ObjectType::hasInlineStorage(reinterpret_cast<SbkObjectType*>(SbkType<T>())))
+            return createInlineWrapper<T>(cppobj);
         PyObject* obj = createWrapper<T>(new T(cppobj), true, true);
 //         SbkBaseWrapper_setContainsCppWrapper(obj, SbkTypeInfo<T>::isCppWrapper);
         return obj;
@@ -317,6 +367,24 @@ struct OverFlowChecker<float, true>
     }
 };
 
+/**
+ * Checks if a value of the integer type Source overflows when cast to the integer type T.
+ * The check is resolved at compile time to nothing when T can hold all the values of Source.
+ */
+template <typename T, typename Source,
+          bool holdsSource = ((std::numeric_limits<T>::is_signed || !std::numeric_limits<Source>::is_signed)
+                              && std::numeric_limits<T>::digits >= std::numeric_limits<Source>::digits)>
+struct RangeChecker
+{
+    static inline bool overflows(Source value) { return OverFlowChecker<T>::check(value); }
+};
+
+template <typename T, typename Source>
+struct RangeChecker<T, Source, true>
+{
+    static inline bool overflows(Source) { return false; }
+};
+
 template <typename PyIntEquiv>
 struct Converter_PyInt
 {
@@ -326,7 +394,12 @@ struct Converter_PyInt
     static inline PyObject* toPython(const PyIntEquiv& cppobj) { return PyInt_FromLong((long) cppobj); }
     static PyIntEquiv toCpp(PyObject* pyobj)
     {
-        if (PyFloat_Check(pyobj)) {
+        if (PyInt_CheckExact(pyobj) || PyBool_Check(pyobj)) {
+            long result = PyInt_AS_LONG(pyobj);
+            if (RangeChecker<PyIntEquiv, long>::overflows(result))
+                PyErr_SetObject(PyExc_OverflowError, 0);
+            return static_cast<PyIntEquiv>(result);
+        } else if (PyFloat_Check(pyobj)) {
             double d_result = PyFloat_AS_DOUBLE(pyobj);
             // If cast to long directly it could overflow silently
             if (OverFlowChecker<PyIntEquiv>::check(d_result))
@@ -395,7 +468,12 @@ struct Converter<PY_LONG_LONG>
 {
     static inline PyObject* toPython(void* cppobj) { return toPython(*reinterpret_cast<PY_LONG_LONG*>(cppobj)); }
     static inline PyObject* toPython(PY_LONG_LONG cppobj) { return PyLong_FromLongLong(cppobj); }
-    static inline PY_LONG_LONG toCpp(PyObject* pyobj) { return (PY_LONG_LONG) PyLong_AsLongLong(pyobj); }
+    static inline PY_LONG_LONG toCpp(PyObject* pyobj)
+    {
+        if (PyInt_CheckExact(pyobj) || PyBool_Check(pyobj))
+            return PyInt_AS_LONG(pyobj);
+        return (PY_LONG_LONG) PyLong_AsLongLong(pyobj);
+    }
 };
 
 template <>
@@ -424,6 +502,10 @@ struct Converter_PyFloat
     static inline PyObject* toPython(PyFloatEquiv cppobj) { return PyFloat_FromDouble((double) cppobj); }
     static inline PyFloatEquiv toCpp(PyObject* pyobj)
     {
+        if (PyFloat_CheckExact(pyobj))
+            return (PyFloatEquiv) PyFloat_AS_DOUBLE(pyobj);
+        if (PyInt_CheckExact(pyobj) || PyBool_Check(pyobj))
+            return (PyFloatEquiv) PyInt_AS_LONG(pyobj);
         if (PyInt_Check(pyobj) || PyLong_Check(pyobj))
             return (PyFloatEquiv) PyLong_AsLong(pyobj);
         return (PyFloatEquiv) PyFloat_AsDouble(pyobj);
@@ -433,6 +515,100 @@ struct Converter_PyFloat
 template <> struct Converter<float> : Converter_PyFloat<float> {};
 template <> struct Converter<double> : Converter_PyFloat<double> {};
 
+// Bulk numeric sequence conversions ------------------------------------------
+
+/**
+ * Converts all the items of a list or tuple, as returned by PySequence_Fast, to the numeric type T
+ * in tight loops over the item array, without calling the per item converter. It applies only when
+ * the items are all exact Python ints (or exact ints and floats for floating point types), and the
+ * range of integers is checked once with their minimum and maximum values.
+ * When the sequence doesn't qualify nothing is converted and false is returned, so that the caller
+ * falls back to the per item conversion, which reports any error.
+ */
+template <typename T,
+          bool isNumber = std::numeric_limits<T>::is_specialized,
+          bool isInteger = std::numeric_limits<T>::is_integer>
+struct NumericSequenceConverter
+{
+    static inline bool isConvertible(PyObject*) { return false; }
+    template <typename Container>
+    static inline bool toCpp(PyObject*, Container&) { return false; }
+};
+
+template <typename T>
+struct NumericSequenceConverter<T, true, true>
+{
+    static bool isConvertible(PyObject* fastSequence)
+    {
+        PyObject** items = PySequence_Fast_ITEMS(fastSequence);
+        for (Py_ssize_t i = 0, max = PySequence_Fast_GET_SIZE(fastSequence); i < max; ++i) {
+            if (!PyInt_CheckExact(items[i]))
+                return false;
+        }
+        return true;
+    }
+
+    /// Appends the converted items to \p container, which must be empty.
+    template <typename Container>
+    static bool toCpp(PyObject* fastSequence, Container& container)
+    {
+        Py_ssize_t size = PySequence_Fast_GET_SIZE(fastSequence);
+        PyObject** items = PySequence_Fast_ITEMS(fastSequence);
+        if (!size)
+            return true;
+        if (!PyInt_CheckExact(items[0]))
+            return false;
+        long minValue = PyInt_AS_LONG(items[0]);
+        long maxValue = minValue;
+        for (Py_ssize_t i = 1; i < size; ++i) {
+            if (!PyInt_CheckExact(items[i]))
+                return false;
+            long value = PyInt_AS_LONG(items[i]);
+            if (value < minValue)
+                minValue = value;
+            else if (value > maxValue)
+                maxValue = value;
+        }
+        if (OverFlowChecker<T>::check(minValue) || OverFlowChecker<T>::check(maxValue))
+            return false;
+        for (Py_ssize_t i = 0; i < size; ++i)
+            container.push_back(static_cast<T>(PyInt_AS_LONG(items[i])));
+        return true;
+    }
+};
+
+template <typename T>
+struct NumericSequenceConverter<T, true, false>
+{
+    static bool isConvertible(PyObject* fastSequence)
+    {
+        PyObject** items = PySequence_Fast_ITEMS(fastSequence);
+        for (Py_ssize_t i = 0, max = PySequence_Fast_GET_SIZE(fastSequence); i < max; ++i) {
+            if (!PyFloat_CheckExact(items[i]) && !PyInt_CheckExact(items[i]))
+                return false;
+        }
+        return true;
+    }
+
+    /// Appends the converted items to \p container, which must be empty.
+    template <typename Container>
+    static bool toCpp(PyObject* fastSequence, Container& container)
+    {
+        if (!isConvertible(fastSequence))
+            return false;
+        PyObject** items = PySequence_Fast_ITEMS(fastSequence);
+        for (Py_ssize_t i = 0, max = PySequence_Fast_GET_SIZE(fastSequence); i < max; ++i) {
+            PyObject* item = items[i];
+            double value = PyFloat_CheckExact(item) ? PyFloat_AS_DOUBLE(item) : PyInt_AS_LONG(item);
+            container.push_back(static_cast<T>(value));
+        }
+        return true;
+    }
+};
+
+// bool is converted from the truth value of any int, not from a range of numbers.
+template <> struct NumericSequenceConverter<bool, true, true> : NumericSequenceConverter<bool, false, false> {};
+
 // PyEnum Conversions ---------------------------------------------------------
 template <typename CppEnum>
 struct EnumConverter
@@ -490,16 +666,176 @@ template <> struct Converter<std::string> : Converter_CString<std::string>
 };
 
 // C++ containers -------------------------------------------------------------
-// The following container converters are meant to be used for pairs, lists and maps
+// The following container converters are meant to be used for pairs, lists, sets and maps
 // that are similar to the STL containers of the same name.
 
 // For example to create a converter for a std::list the following code is enough:
 // template<typename T> struct Converter<std::list<T> > : StdListConverter<std::list<T> > {};
 
-// And this for a std::map:
+// StdListConverter also serves std::vector and std::deque, and StdSetConverter std::set:
+// template<typename T> struct Converter<std::vector<T> > : StdListConverter<std::vector<T> > {};
+// template<typename T> struct Converter<std::set<T> > : StdSetConverter<std::set<T> > {};
+
+// std::tr1::tuple types are converted by StdTupleConverter, from sbktupleconverter.h.
+
+// And this for a std::map, or a hash map like std::tr1::unordered_map:
 // template<typename KT, typename VT>
 // struct Converter<std::map<KT, VT> > : StdMapConverter<std::map<KT, VT> > {};
 
+/**
+ * Reserves room for the items converted from Python, before they are inserted in a container.
+ * The default does nothing, specialize it for the containers that can do better. Hash based
+ * containers can use HashContainerReserve:
+ *
+ * template<typename KT, typename VT>
+ * struct ContainerReserve<std::tr1::unordered_map<KT, VT> >
+ *     : HashContainerReserve<std::tr1::unordered_map<KT, VT> > {};
+ */
+template <typename Container>
+struct ContainerReserve
+{
+    static inline void reserve(Container&, Py_ssize_t) {}
+};
+
+template <typename T, typename Alloc>
+struct ContainerReserve<std::vector<T, Alloc> >
+{
+    static inline void reserve(std::vector<T, Alloc>& container, Py_ssize_t size) { container.reserve(size); }
+};
+
+/// Avoids the rehashes of hash based containers while they are filled.
+template <typename HashContainer>
+struct HashContainerReserve
+{
+    static inline void reserve(HashContainer& container, Py_ssize_t size)
+    {
+        container.rehash(typename HashContainer::size_type(size / container.max_load_factor()) + 1);
+    }
+};
+
+// Reserves room for \p size items in the containers that support it.
+template <typename Container>
+inline void reserveContainer(Container& container, Py_ssize_t size)
+{
+    ContainerReserve<Container>::reserve(container, size);
+}
+
+/**
+ * Tells if values of type T can be copied, compared, hashed and destroyed without holding the
+ * GIL. True for the numeric types and std::string, bindings may specialize it for their own
+ * plain value types.
+ */
+template <typename T>
+struct IsPlainValue
+{
+    enum { value = std::numeric_limits<T>::is_specialized };
+};
+
+template <>
+struct IsPlainValue<std::string>
+{
+    enum { value = true };
+};
+
+template <typename T1, typename T2>
+struct IsPlainValue<std::pair<T1, T2> >
+{
+    enum { value = IsPlainValue<T1>::value && IsPlainValue<T2>::value };
+};
+
+/// Item count from which the C++ containers of plain values are built with the GIL released.
+const Py_ssize_t UNLOCKED_CONTAINER_BUILD_SIZE = 1024;
+
+/**
+ * Inserts the already converted \p items in \p container. Ordered containers sort the items
+ * first, so that their trees are built with constant time insertions at the end.
+ */
+template <typename Container>
+struct ContainerBuilder
+{
+    template <typename Item>
+    static inline void build(Container& container, std::vector<Item>& items)
+    {
+        container.insert(items.begin(), items.end());
+    }
+};
+
+template <typename Key, typename Compare, typename Alloc>
+struct ContainerBuilder<std::set<Key, Compare, Alloc> >
+{
+    static inline void build(std::set<Key, Compare, Alloc>& container, std::vector<Key>& items)
+    {
+        // Stable, so that the first of the equivalent items is the one kept, as when inserting.
+        std::stable_sort(items.begin(), items.end(), container.key_comp());
+        container.insert(items.begin(), items.end());
+    }
+};
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+struct ContainerBuilder<std::map<Key, T, Compare, Alloc> >
+{
+    typedef std::pair<Key, T> Item;
+
+    struct KeyCompare
+    {
+        Compare compare;
+        KeyCompare(const Compare& compare) : compare(compare) {}
+        inline bool operator()(const Item& item1, const Item& item2) const { return compare(item1.first, item2.first); }
+    };
+
+    static inline void build(std::map<Key, T, Compare, Alloc>& container, std::vector<Item>& items)
+    {
+        std::stable_sort(items.begin(), items.end(), KeyCompare(container.key_comp()));
+        container.insert(items.begin(), items.end());
+    }
+};
+
+/**
+ * Second phase of the conversion of Python containers of plain values, the first being the
+ * conversion of their items to \p items while holding the GIL: builds \p container from the
+ * converted items. Allocations, comparisons and hashing of plain values don't touch Python,
+ * so the GIL is released while building large containers, and other Python threads can run.
+ */
+template <typename Container, typename Item>
+inline void buildContainer(Container& container, std::vector<Item>& items)
+{
+    ThreadStateSaver threadState;
+    if (Py_ssize_t(items.size()) >= UNLOCKED_CONTAINER_BUILD_SIZE)
+        threadState.save();
+    reserveContainer(container, items.size());
+    ContainerBuilder<Container>::build(container, items);
+}
+
+/**
+ * Fills a C++ container with the items converted from a Python container. Plain values are
+ * collected and inserted by buildContainer once all of them are converted. Other items are
+ * inserted as they come, so they only need to be copy constructible.
+ */
+template <typename Container, typename Item, bool isPlainValue = IsPlainValue<Item>::value>
+class ContainerFiller
+{
+public:
+    ContainerFiller(Container& container, Py_ssize_t size) : m_container(container) { m_items.reserve(size); }
+    inline void add(const Item& item) { m_items.push_back(item); }
+    inline void finish() { buildContainer(m_container, m_items); }
+
+private:
+    Container& m_container;
+    std::vector<Item> m_items;
+};
+
+template <typename Container, typename Item>
+class ContainerFiller<Container, Item, false>
+{
+public:
+    ContainerFiller(Container& container, Py_ssize_t size) : m_container(container) { reserveContainer(container, size); }
+    inline void add(const Item& item) { m_container.insert(item); }
+    inline void finish() {}
+
+private:
+    Container& m_container;
+};
+
 template <typename StdList>
 struct StdListConverter
 {
@@ -510,17 +846,20 @@ struct StdListConverter
 
     static inline bool isConvertible(PyObject* pyObj)
     {
-        if (PyObject_TypeCheck(pyObj, SbkType<StdList>()))
+        if (PyObject_TypeCheck(pyObj, SbkType<StdList>()) || sharedListPointer<StdList>(pyObj))
             return true;
-        // Sequence conversion are made ONLY for python sequences, not for
-        // binded types implementing sequence protocol, otherwise this will
-        // cause a mess like QBitArray being accepted by someone expecting a
-        // QStringList.
-        if ((SbkType<StdList>() && Object::checkType(pyObj)) || !PySequence_Check(pyObj))
+        if (!isConvertibleSequence(pyObj))
+            return false;
+        AutoDecRef fastSequence(PySequence_Fast(pyObj, "Sequence expected."));
+        if (fastSequence.isNull()) {
+            PyErr_Clear();
             return false;
-        for (int i = 0, max = PySequence_Length(pyObj); i < max; ++i) {
-            AutoDecRef item(PySequence_GetItem(pyObj, i));
-            if (!Converter<typename StdList::value_type>::isConvertible(item))
+        }
+        if (NumericSequenceConverter<typename StdList::value_type>::isConvertible(fastSequence.object()))
+            return true;
+        PyObject** items = PySequence_Fast_ITEMS(fastSequence.object());
+        for (Py_ssize_t i = 0, max = PySequence_Fast_GET_SIZE(fastSequence.object()); i < max; ++i) {
+            if (!Converter<typename StdList::value_type>::isConvertible(items[i]))
                 return false;
         }
         return true;
@@ -540,14 +879,134 @@ struct StdListConverter
     {
         if (PyObject_TypeCheck(pyobj, SbkType<StdList>()))
             return *reinterpret_cast<StdList*>(Object::cppPointer(reinterpret_cast<SbkObject*>(pyobj), SbkType<StdList>()));
+        if (StdList* shared = sharedListPointer<StdList>(pyobj))
+            return *shared;
 
         StdList result;
-        for (int i = 0; i < PySequence_Size(pyobj); i++) {
-            AutoDecRef pyItem(PySequence_GetItem(pyobj, i));
-            result.push_back(Converter<typename StdList::value_type>::toCpp(pyItem));
-        }
+        AutoDecRef fastSequence(PySequence_Fast(pyobj, "Sequence expected."));
+        if (fastSequence.isNull())
+            return result;
+        Py_ssize_t size = PySequence_Fast_GET_SIZE(fastSequence.object());
+        PyObject** items = PySequence_Fast_ITEMS(fastSequence.object());
+        reserveContainer(result, size);
+        if (NumericSequenceConverter<typename StdList::value_type>::toCpp(fastSequence.object(), result))
+            return result;
+        for (Py_ssize_t i = 0; i < size; ++i)
+            result.push_back(Converter<typename StdList::value_type>::toCpp(items[i]));
         return result;
     }
+
+    /**
+     * Checks and converts each item of \p pyobj only once, walking the sequence a single time.
+     * Returns false, without setting a Python error, if \p pyobj or any of its items can't be
+     * converted; \p result is left empty in this case.
+     */
+    static bool tryToCpp(PyObject* pyobj, StdList& result)
+    {
+        result.clear();
+        if (PyObject_TypeCheck(pyobj, SbkType<StdList>())) {
+            result = *reinterpret_cast<StdList*>(Object::cppPointer(reinterpret_cast<SbkObject*>(pyobj), SbkType<StdList>()));
+            return true;
+        }
+        if (StdList* shared = sharedListPointer<StdList>(pyobj)) {
+            result = *shared;
+            return true;
+        }
+        if (!isConvertibleSequence(pyobj))
+            return false;
+        AutoDecRef fastSequence(PySequence_Fast(pyobj, "Sequence expected."));
+        if (fastSequence.isNull()) {
+            PyErr_Clear();
+            return false;
+        }
+        Py_ssize_t size = PySequence_Fast_GET_SIZE(fastSequence.object());
+        PyObject** items = PySequence_Fast_ITEMS(fastSequence.object());
+        reserveContainer(result, size);
+        if (NumericSequenceConverter<typename StdList::value_type>::toCpp(fastSequence.object(), result))
+            return true;
+        for (Py_ssize_t i = 0; i < size; ++i) {
+            if (!Converter<typename StdList::value_type>::isConvertible(items[i])) {
+                result.clear();
+                return false;
+            }
+            result.push_back(Converter<typename StdList::value_type>::toCpp(items[i]));
+            if (PyErr_Occurred()) {
+                PyErr_Clear();
+                result.clear();
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static inline bool isConvertibleSequence(PyObject* pyObj)
+    {
+        // Sequence conversion are made ONLY for python sequences, not for
+        // binded types implementing sequence protocol, otherwise this will
+        // cause a mess like QBitArray being accepted by someone expecting a
+        // QStringList.
+        return !(SbkType<StdList>() && Object::checkType(pyObj)) && PySequence_Check(pyObj);
+    }
+};
+
+/// Tells at compile time if Converter<T> has a tryToCpp(PyObject*, T&) function, like StdListConverter.
+template <typename T>
+struct HasTryToCpp
+{
+    typedef char Yes;
+    typedef char (&No)[2];
+    template <typename U, bool (*)(PyObject*, U&)> struct Signature;
+    template <typename C> static Yes test(Signature<T, &C::tryToCpp>*);
+    template <typename C> static No test(...);
+    enum { value = sizeof(test<Converter<T> >(0)) == sizeof(Yes) };
+};
+
+/**
+ * Keeps the container converted from a Python argument while the overload decisor checks it,
+ * so that the chosen overload uses it instead of converting the argument again. Containers
+ * whose converter has no tryToCpp are checked with isConvertible and converted by toCpp.
+ */
+template <typename T, bool singleWalk = HasTryToCpp<T>::value>
+class ConvertedArgument
+{
+public:
+    inline bool check(PyObject* pyObj) { return Converter<T>::isConvertible(pyObj); }
+    inline T& toCpp(PyObject* pyObj)
+    {
+        m_value = Converter<T>::toCpp(pyObj);
+        return m_value;
+    }
+
+private:
+    T m_value;
+};
+
+template <typename T>
+class ConvertedArgument<T, true>
+{
+public:
+    ConvertedArgument() : m_converted(false) {}
+
+    inline bool check(PyObject* pyObj)
+    {
+        m_converted = Converter<T>::tryToCpp(pyObj, m_value);
+        // An argument accepted by isConvertible whose items failed to convert, e.g. with an
+        // overflow, is converted again by toCpp, which raises the error.
+        return m_converted || Converter<T>::isConvertible(pyObj);
+    }
+
+    /// Returns the container converted by check(), or converts \p pyObj if there isn't one.
+    inline T& toCpp(PyObject* pyObj)
+    {
+        if (!m_converted)
+            m_value = Converter<T>::toCpp(pyObj);
+        return m_value;
+    }
+
+private:
+    T m_value;
+    bool m_converted;
 };
 
 template <typename StdPair>
@@ -562,6 +1021,11 @@ struct StdPairConverter
     {
         if (PyObject_TypeCheck(pyObj, SbkType<StdPair>()))
             return true;
+        if (PyTuple_CheckExact(pyObj)) {
+            return PyTuple_GET_SIZE(pyObj) == 2
+                   && Converter<typename StdPair::first_type>::isConvertible(PyTuple_GET_ITEM(pyObj, 0))
+                   && Converter<typename StdPair::second_type>::isConvertible(PyTuple_GET_ITEM(pyObj, 1));
+        }
         if ((SbkType<StdPair>() && Object::checkType(pyObj)) || !PySequence_Check(pyObj) || PySequence_Length(pyObj) != 2)
             return false;
 
@@ -569,7 +1033,7 @@ struct StdPairConverter
         AutoDecRef item2(PySequence_GetItem(pyObj, 1));
 
         if (!Converter<typename StdPair::first_type>::isConvertible(item1)
-            && !Converter<typename StdPair::second_type>::isConvertible(item2)) {
+            || !Converter<typename StdPair::second_type>::isConvertible(item2)) {
             return false;
         }
         return true;
@@ -586,6 +1050,10 @@ struct StdPairConverter
     }
     static StdPair toCpp(PyObject* pyobj)
     {
+        if (PyTuple_CheckExact(pyobj)) {
+            return StdPair(Converter<typename StdPair::first_type>::toCpp(PyTuple_GET_ITEM(pyobj, 0)),
+                           Converter<typename StdPair::second_type>::toCpp(PyTuple_GET_ITEM(pyobj, 1)));
+        }
         StdPair result;
         AutoDecRef pyFirst(PySequence_GetItem(pyobj, 0));
         AutoDecRef pySecond(PySequence_GetItem(pyobj, 1));
@@ -595,6 +1063,13 @@ struct StdPairConverter
     }
 };
 
+namespace MapProxy
+{
+// Declared in sbkmapproxy.h, which needs the converters of this header.
+LIBSHIBOKEN_API bool check(PyObject* pyObj);
+LIBSHIBOKEN_API PyObject* toDict(PyObject* pyObj);
+}
+
 template <typename StdMap>
 struct StdMapConverter
 {
@@ -607,7 +1082,18 @@ struct StdMapConverter
     {
         if (PyObject_TypeCheck(pyObj, SbkType<StdMap>()))
             return true;
-        if ((SbkType<StdMap>() && Object::checkType(pyObj)) || !PyDict_Check(pyObj))
+        if (SbkType<StdMap>() && Object::checkType(pyObj))
+            return false;
+        // Maps returned as lazy proxies can be passed back, their items are checked as a dict.
+        if (MapProxy::check(pyObj)) {
+            AutoDecRef dict(MapProxy::toDict(pyObj));
+            if (dict.isNull()) {
+                PyErr_Clear();
+                return false;
+            }
+            return isConvertible(dict);
+        }
+        if (!PyDict_Check(pyObj))
             return false;
 
         PyObject* key;
@@ -616,7 +1102,7 @@ struct StdMapConverter
 
         while (PyDict_Next(pyObj, &pos, &key, &value)) {
             if (!Converter<typename StdMap::key_type>::isConvertible(key)
-                && !Converter<typename StdMap::mapped_type>::isConvertible(value)) {
+                || !Converter<typename StdMap::mapped_type>::isConvertible(value)) {
                 return false;
             }
         }
@@ -630,30 +1116,95 @@ struct StdMapConverter
         typename StdMap::const_iterator it = cppobj.begin();
 
         for (; it != cppobj.end(); ++it) {
-            PyDict_SetItem(result,
-                           Converter<typename StdMap::key_type>::toPython(it->first),
-                           Converter<typename StdMap::mapped_type>::toPython(it->second));
+            AutoDecRef key(Converter<typename StdMap::key_type>::toPython(it->first));
+            AutoDecRef value(Converter<typename StdMap::mapped_type>::toPython(it->second));
+            PyDict_SetItem(result, key, value);
         }
 
         return result;
     }
     static StdMap toCpp(PyObject* pyobj)
     {
+        typedef std::pair<typename StdMap::key_type, typename StdMap::mapped_type> Item;
         StdMap result;
+        if (MapProxy::check(pyobj)) {
+            AutoDecRef dict(MapProxy::toDict(pyobj));
+            if (dict.isNull())
+                return result;
+            return toCpp(dict);
+        }
 
         PyObject* key;
         PyObject* value;
         Py_ssize_t pos = 0;
 
+        ContainerFiller<StdMap, Item> filler(result, PyDict_Size(pyobj));
         while (PyDict_Next(pyobj, &pos, &key, &value)) {
-            result.insert(typename StdMap::value_type(
-                    Converter<typename StdMap::key_type>::toCpp(key),
-                    Converter<typename StdMap::mapped_type>::toCpp(value)));
+            filler.add(Item(Converter<typename StdMap::key_type>::toCpp(key),
+                            Converter<typename StdMap::mapped_type>::toCpp(value)));
         }
+        filler.finish();
         return result;
     }
 };
 
+template <typename StdSet>
+struct StdSetConverter
+{
+    static inline bool checkType(PyObject* pyObj)
+    {
+        return isConvertible(pyObj);
+    }
+
+    static inline bool isConvertible(PyObject* pyObj)
+    {
+        if (PyObject_TypeCheck(pyObj, SbkType<StdSet>()))
+            return true;
+        if ((SbkType<StdSet>() && Object::checkType(pyObj)) || !(PyAnySet_Check(pyObj) || PySequence_Check(pyObj)))
+            return false;
+        AutoDecRef fastSequence(PySequence_Fast(pyObj, "Sequence expected."));
+        if (fastSequence.isNull()) {
+            PyErr_Clear();
+            return false;
+        }
+        PyObject** items = PySequence_Fast_ITEMS(fastSequence.object());
+        for (Py_ssize_t i = 0, max = PySequence_Fast_GET_SIZE(fastSequence.object()); i < max; ++i) {
+            if (!Converter<typename StdSet::value_type>::isConvertible(items[i]))
+                return false;
+        }
+        return true;
+    }
+
+    static PyObject* toPython(void* cppObj) { return toPython(*reinterpret_cast<StdSet*>(cppObj)); }
+    static PyObject* toPython(const StdSet& cppobj)
+    {
+        PyObject* result = PySet_New(0);
+        for (typename StdSet::const_iterator it = cppobj.begin(); it != cppobj.end(); ++it) {
+            AutoDecRef item(Converter<typename StdSet::value_type>::toPython(*it));
+            PySet_Add(result, item);
+        }
+        return result;
+    }
+
+    static StdSet toCpp(PyObject* pyobj)
+    {
+        if (PyObject_TypeCheck(pyobj, SbkType<StdSet>()))
+            return *reinterpret_cast<StdSet*>(Object::cppPointer(reinterpret_cast<SbkObject*>(pyobj), SbkType<StdSet>()));
+
+        StdSet result;
+        // Sets are copied to a tuple, to walk their items as borrowed references.
+        AutoDecRef fastSequence(PySequence_Fast(pyobj, "Sequence expected."));
+        if (fastSequence.isNull())
+            return result;
+        Py_ssize_t size = PySequence_Fast_GET_SIZE(fastSequence.object());
+        PyObject** items = PySequence_Fast_ITEMS(fastSequence.object());
+        ContainerFiller<StdSet, typename StdSet::value_type> filler(result, size);
+        for (Py_ssize_t i = 0; i < size; ++i)
+            filler.add(Converter<typename StdSet::value_type>::toCpp(items[i]));
+        filler.finish();
+        return result;
+    }
+};
 
 // class used to translate python objects to another type
 template <typename T> struct PythonConverter {};
@@ -126,4 +126,10 @@ int warning(PyObject *category, int stacklevel, const char *format, ...)
     return result;
 }
 
+bool hasTruncMethod(PyObject* pyObj)
+{
+    static PyObject* truncName = PyString_InternFromString("__trunc__");
+    return PyObject_HasAttr(pyObj, truncName);
+}
+
 } // namespace Shiboken
@@ -25,12 +25,13 @@
 
 #include <Python.h>
 #include "shibokenmacros.h"
-#include "conversions.h"
 #include "autodecref.h"
 
 namespace Shiboken
 {
 
+template <typename T> struct Converter;
+
 template<typename A>
 inline PyObject* makeTuple(const A& a)
 {
@@ -92,6 +93,12 @@ LIBSHIBOKEN_API bool sequenceToArgcArgv(PyObject* argList, int* argc, char*** ar
  */
 LIBSHIBOKEN_API int* sequenceToIntArray(PyObject* obj, bool zeroTerminated = false);
 
+/**
+ *  Returns true if \p pyObj has a __trunc__ attribute, looked up with a cached name object instead
+ *  of creating a new string on every call.
+ */
+LIBSHIBOKEN_API bool hasTruncMethod(PyObject* pyObj);
+
 /**
  *  Creates and automatically deallocates C++ arrays.
  */
@@ -114,4 +121,7 @@ LIBSHIBOKEN_API int warning(PyObject *category, int stacklevel, const char *form
 
 } // namespace Shiboken
 
+// Included last because conversions.h uses the functions declared here.
+#include "conversions.h"
+
 #endif // HELPER_H
@@ -60,6 +60,7 @@ typedef struct {
 #define PyBUF_F_CONTIGUOUS (0x0040 | PyBUF_STRIDES)
 #define PyBUF_ANY_CONTIGUOUS (0x0080 | PyBUF_STRIDES)
 #define PyBUF_INDIRECT (0x0100 | PyBUF_STRIDES)
+#define PyBUF_FULL_RO (PyBUF_INDIRECT | PyBUF_FORMAT)
 
 #endif
 #if PY_MAJOR_VERSION < 3
@@ -0,0 +1,227 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "sbkarray.h"
+#include "autodecref.h"
+#include "basewrapper.h"
+
+extern "C"
+{
+
+struct SbkArray
+{
+    PyObject_HEAD
+    Shiboken::Array::Storage* storage;
+};
+
+static inline Shiboken::Array::Storage* storageOf(PyObject* self)
+{
+    return reinterpret_cast<SbkArray*>(self)->storage;
+}
+
+static void SbkArray_dealloc(PyObject* self)
+{
+    delete storageOf(self);
+    PyObject_Del(self);
+}
+
+static Py_ssize_t SbkArray_length(PyObject* self)
+{
+    return storageOf(self)->size();
+}
+
+static PyObject* SbkArray_item(PyObject* self, Py_ssize_t index)
+{
+    if (index < 0 || index >= storageOf(self)->size()) {
+        PyErr_SetString(PyExc_IndexError, "array index out of range");
+        return 0;
+    }
+    return storageOf(self)->item(index);
+}
+
+static PyObject* SbkArray_repr(PyObject* self)
+{
+    Shiboken::AutoDecRef list(Shiboken::Array::toList(self));
+    if (list.isNull())
+        return 0;
+    return PyObject_Repr(list);
+}
+
+static PyObject* SbkArray_richcompare(PyObject* self, PyObject* other, int op)
+{
+    if (!(PyList_Check(other) || Shiboken::Array::check(other))) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+    Shiboken::AutoDecRef list(Shiboken::Array::toList(self));
+    Shiboken::AutoDecRef otherList(Shiboken::Array::check(other) ? Shiboken::Array::toList(other) : (Py_INCREF(other), other));
+    if (list.isNull() || otherList.isNull())
+        return 0;
+    return PyObject_RichCompare(list, otherList, op);
+}
+
+#if PY_VERSION_HEX >= 0x02060000
+static int SbkArray_getbuffer(PyObject* self, Py_buffer* view, int flags)
+{
+    Shiboken::Buffer::Layout layout;
+    storageOf(self)->layout(&layout);
+    return Shiboken::Buffer::fillInfo(view, self, layout, flags);
+}
+
+static PyBufferProcs SbkArray_as_buffer = {
+#if PY_MAJOR_VERSION < 3
+    /*bf_getreadbuffer*/    &Shiboken::Buffer::readBufferProc,
+    /*bf_getwritebuffer*/   &Shiboken::Buffer::writeBufferProc,
+    /*bf_getsegcount*/      &Shiboken::Buffer::segmentCountProc,
+    /*bf_getcharbuffer*/    &Shiboken::Buffer::charBufferProc,
+#endif
+    /*bf_getbuffer*/        &SbkArray_getbuffer,
+    /*bf_releasebuffer*/    &Shiboken::Buffer::releaseInfo
+};
+#endif
+
+static PySequenceMethods SbkArray_as_sequence = {
+    /*sq_length*/           SbkArray_length,
+    /*sq_concat*/           0,
+    /*sq_repeat*/           0,
+    /*sq_item*/             SbkArray_item,
+    /*sq_slice*/            0,
+    /*sq_ass_item*/         0,
+    /*sq_ass_slice*/        0,
+    /*sq_contains*/         0
+};
+
+PyTypeObject SbkArray_Type = {
+    PyObject_HEAD_INIT(0)
+    /*ob_size*/             0,
+    /*tp_name*/             "Shiboken.Array",
+    /*tp_basicsize*/        sizeof(SbkArray),
+    /*tp_itemsize*/         0,
+    /*tp_dealloc*/          SbkArray_dealloc,
+    /*tp_print*/            0,
+    /*tp_getattr*/          0,
+    /*tp_setattr*/          0,
+    /*tp_compare*/          0,
+    /*tp_repr*/             SbkArray_repr,
+    /*tp_as_number*/        0,
+    /*tp_as_sequence*/      &SbkArray_as_sequence,
+    /*tp_as_mapping*/       0,
+    /*tp_hash*/             0,
+    /*tp_call*/             0,
+    /*tp_str*/              0,
+    /*tp_getattro*/         0,
+    /*tp_setattro*/         0,
+#if PY_VERSION_HEX >= 0x02060000
+    /*tp_as_buffer*/        &SbkArray_as_buffer,
+#else
+    /*tp_as_buffer*/        0,
+#endif
+    /*tp_flags*/            Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER,
+    /*tp_doc*/              "Array of numbers stored in a C++ container, exported without copies to buffer and array consumers.",
+    /*tp_traverse*/         0,
+    /*tp_clear*/            0,
+    /*tp_richcompare*/      SbkArray_richcompare,
+    /*tp_weaklistoffset*/   0,
+    /*tp_iter*/             0,
+    /*tp_iternext*/         0,
+    /*tp_methods*/          0,
+    /*tp_members*/          0,
+    /*tp_getset*/           Shiboken::Buffer::arrayInterfaceGetSet,
+    /*tp_base*/             0,
+    /*tp_dict*/             0,
+    /*tp_descr_get*/        0,
+    /*tp_descr_set*/        0,
+    /*tp_dictoffset*/       0,
+    /*tp_init*/             0,
+    /*tp_alloc*/            0,
+    /*tp_new*/              0,
+    /*tp_free*/             0,
+    /*tp_is_gc*/            0,
+    /*tp_bases*/            0,
+    /*tp_mro*/              0,
+    /*tp_cache*/            0,
+    /*tp_subclasses*/       0,
+    /*tp_weaklist*/         0
+};
+
+} // extern "C"
+
+namespace Shiboken
+{
+namespace Array
+{
+
+PyObject* newObject(Storage* storage)
+{
+    SbkArray* self = PyObject_New(SbkArray, &SbkArray_Type);
+    if (!self) {
+        delete storage;
+        return 0;
+    }
+    self->storage = storage;
+    return reinterpret_cast<PyObject*>(self);
+}
+
+bool check(PyObject* pyObj)
+{
+    return PyObject_TypeCheck(pyObj, &SbkArray_Type);
+}
+
+PyObject* toList(PyObject* pyObj)
+{
+    Py_ssize_t size = storageOf(pyObj)->size();
+    PyObject* result = PyList_New(size);
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        PyObject* item = storageOf(pyObj)->item(i);
+        if (!item) {
+            Py_DECREF(result);
+            return 0;
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+    return result;
+}
+
+bool cppPointers(PyObject* sequence, PyTypeObject* type, std::vector<void*>& objects)
+{
+    AutoDecRef fastSequence(PySequence_Fast(sequence, "expected a sequence"));
+    if (fastSequence.isNull())
+        return false;
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(fastSequence.object());
+    PyObject** items = PySequence_Fast_ITEMS(fastSequence.object());
+
+    objects.resize(count);
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        if (!PyObject_TypeCheck(items[i], type)) {
+            PyErr_Format(PyExc_TypeError, "expected '%s' items, got '%s'", type->tp_name, items[i]->ob_type->tp_name);
+            return false;
+        }
+        SbkObject* item = reinterpret_cast<SbkObject*>(items[i]);
+        if (!Object::isValid(item))
+            return false;
+        objects[i] = Object::cppPointer(item, type);
+    }
+    return true;
+}
+
+} // namespace Array
+} // namespace Shiboken
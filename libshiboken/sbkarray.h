@@ -0,0 +1,134 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SBKARRAY_H
+#define SBKARRAY_H
+
+#include <Python.h>
+#include <vector>
+#include "shibokenmacros.h"
+#include "shibokenbuffer.h"
+
+extern "C"
+{
+
+extern LIBSHIBOKEN_API PyTypeObject SbkArray_Type;
+
+} // extern "C"
+
+namespace Shiboken
+{
+
+template <typename T> struct Converter;
+
+namespace Array
+{
+
+/**
+ *  Contiguous C++ numeric storage owned by an array, which exports it through the buffer
+ *  protocol and the array interface. Shiboken::VectorStorage implements it for std::vector.
+ */
+class LIBSHIBOKEN_API Storage
+{
+public:
+    virtual ~Storage() {}
+    virtual Py_ssize_t size() const = 0;
+    /// Returns a new reference to the item at \p index, which must be inside the array bounds.
+    virtual PyObject* item(Py_ssize_t index) = 0;
+    /// Describes the memory of the stored items.
+    virtual void layout(Buffer::Layout* layout) = 0;
+};
+
+/// Creates a Python array over \p storage, taking its ownership.
+LIBSHIBOKEN_API PyObject* newObject(Storage* storage);
+/// Returns true if \p pyObj is an array.
+LIBSHIBOKEN_API bool check(PyObject* pyObj);
+/// Returns a new list with all the items of the array \p pyObj.
+LIBSHIBOKEN_API PyObject* toList(PyObject* pyObj);
+/**
+ *  Fills \p objects with the C++ objects of the wrappers of \p type in \p sequence. Returns
+ *  false with a Python error set if an item is not a valid wrapper of \p type.
+ */
+LIBSHIBOKEN_API bool cppPointers(PyObject* sequence, PyTypeObject* type, std::vector<void*>& objects);
+
+} // namespace Array
+
+template <typename StdVector>
+class VectorStorage : public Array::Storage
+{
+public:
+    typedef typename StdVector::value_type ValueType;
+
+    /// Takes the contents of \p vector, which is left empty.
+    explicit VectorStorage(StdVector& vector) { m_vector.swap(vector); }
+
+    Py_ssize_t size() const { return m_vector.size(); }
+
+    PyObject* item(Py_ssize_t index) { return Converter<ValueType>::toPython(m_vector[index]); }
+
+    void layout(Buffer::Layout* layout)
+    {
+        Py_ssize_t size = m_vector.size();
+        layout->memory = m_vector.empty() ? 0 : &m_vector[0];
+        layout->itemSize = sizeof(ValueType);
+        layout->format = Buffer::FormatOf<ValueType>::value();
+        layout->setShape(1, &size);
+    }
+
+private:
+    StdVector m_vector;
+};
+
+/**
+ *  Returns a Python array that takes the contents of the numeric \p vector, and exports them
+ *  without copies through the buffer protocol and the array interface. \p vector is left empty.
+ */
+template <typename StdVector>
+inline PyObject* createArray(StdVector& vector)
+{
+    return Array::newObject(new VectorStorage<StdVector>(vector));
+}
+
+/**
+ *  Returns a Python array with the values returned by the \p getter member function for the
+ *  C++ objects of all the wrappers of \p type in \p sequence, so that a column of values is
+ *  read in one call instead of a method call for every wrapper. Returns 0 with a Python
+ *  error set if any of the calls failed.
+ */
+template <typename Value, typename Class, typename Getter>
+PyObject* createProjectedArray(PyObject* sequence, PyTypeObject* type, Getter getter)
+{
+    std::vector<void*> objects;
+    if (!Array::cppPointers(sequence, type, objects))
+        return 0;
+    std::vector<Value> values(objects.size());
+    for (std::size_t i = 0; i < objects.size(); ++i)
+        values[i] = (reinterpret_cast<Class*>(objects[i])->*getter)();
+    // A virtual getter overridden in Python may have failed.
+    if (PyErr_Occurred())
+        return 0;
+    return createArray(values);
+}
+
+} // namespace Shiboken
+
+#endif // SBKARRAY_H
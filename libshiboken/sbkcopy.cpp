@@ -0,0 +1,140 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "sbkcopy.h"
+#include "basewrapper.h"
+#include "bindingmanager.h"
+#include "autodecref.h"
+
+namespace Shiboken
+{
+
+namespace Copy
+{
+
+bool initialize(SbkObject* self, SbkObjectType* type, const void* source, CopyFunction copy)
+{
+    PyTypeObject* pyType = reinterpret_cast<PyTypeObject*>(type);
+    void* storage = 0;
+    if (ObjectType::hasInlineStorage(type)) {
+        storage = Object::inlineStorage(self, pyType);
+        if (!storage)
+            return false;
+    }
+    void* cptr = copy(source, storage);
+    if (!Object::setCppPointer(self, pyType, cptr))
+        return false;
+    Object::setValidCpp(self, true);
+    BindingManager::instance().registerWrapper(self, cptr);
+    return true;
+}
+
+// Returns a new wrapper of \p resultType with a copy of the C++ object of \p item.
+static PyObject* copyWrapper(SbkObject* item, PyTypeObject* resultType, SbkObjectType* type, CopyFunction copy)
+{
+    if (!Object::isValid(item))
+        return 0;
+    void* cptr = Object::cppPointer(item, reinterpret_cast<PyTypeObject*>(type));
+    PyObject* result = SbkObjectTpNew(resultType, 0, 0);
+    if (result && !initialize(reinterpret_cast<SbkObject*>(result), type, cptr, copy)) {
+        Py_DECREF(result);
+        return 0;
+    }
+    return result;
+}
+
+PyObject* deepCopy(PyObject* self, PyObject* memo, SbkObjectType* type, CopyFunction copy)
+{
+    SbkObject* sbkSelf = reinterpret_cast<SbkObject*>(self);
+    // The copy of a C++ wrapper is a plain C++ object, which can't call Python reimplementations.
+    PyTypeObject* resultType = self->ob_type;
+    if (Object::hasCppWrapper(sbkSelf))
+        resultType = reinterpret_cast<PyTypeObject*>(type);
+    AutoDecRef result(copyWrapper(sbkSelf, resultType, type, copy));
+    if (result.isNull())
+        return 0;
+
+    if (memo && PyDict_Check(memo)) {
+        AutoDecRef id(PyLong_FromVoidPtr(self));
+        if (id.isNull() || PyDict_SetItem(memo, id, result) < 0)
+            return 0;
+    }
+
+    if (resultType == self->ob_type && sbkSelf->ob_dict && PyDict_Size(sbkSelf->ob_dict) > 0) {
+        AutoDecRef copyModule(PyImport_ImportModule("copy"));
+        if (copyModule.isNull())
+            return 0;
+        PyObject* dict = PyObject_CallMethod(copyModule, const_cast<char*>("deepcopy"), const_cast<char*>("OO"),
+                                             sbkSelf->ob_dict, memo ? memo : Py_None);
+        if (!dict)
+            return 0;
+        reinterpret_cast<SbkObject*>(result.object())->ob_dict = dict;
+    }
+
+    Py_INCREF(result.object());
+    return result;
+}
+
+PyObject* copyList(PyObject* sequence, SbkObjectType* type, CopyFunction copy)
+{
+    PyTypeObject* pyType = reinterpret_cast<PyTypeObject*>(type);
+    AutoDecRef fastSequence(PySequence_Fast(sequence, "expected a sequence"));
+    if (fastSequence.isNull())
+        return 0;
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(fastSequence.object());
+    PyObject** items = PySequence_Fast_ITEMS(fastSequence.object());
+
+    PyObject* result = PyList_New(count);
+    if (!result)
+        return 0;
+    PyObject* deepCopyFunc = 0;
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        if (!PyObject_TypeCheck(items[i], pyType)) {
+            PyErr_Format(PyExc_TypeError, "expected '%s' items, got '%s'", pyType->tp_name, items[i]->ob_type->tp_name);
+            Py_DECREF(result);
+            Py_XDECREF(deepCopyFunc);
+            return 0;
+        }
+        PyObject* item;
+        if (items[i]->ob_type == pyType) {
+            item = copyWrapper(reinterpret_cast<SbkObject*>(items[i]), pyType, type, copy);
+        } else {
+            if (!deepCopyFunc) {
+                AutoDecRef copyModule(PyImport_ImportModule("copy"));
+                deepCopyFunc = copyModule.isNull() ? 0 : PyObject_GetAttrString(copyModule, "deepcopy");
+            }
+            item = deepCopyFunc ? PyObject_CallFunctionObjArgs(deepCopyFunc, items[i], 0) : 0;
+        }
+        if (!item) {
+            Py_DECREF(result);
+            Py_XDECREF(deepCopyFunc);
+            return 0;
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+    Py_XDECREF(deepCopyFunc);
+    return result;
+}
+
+} // namespace Copy
+
+} // namespace Shiboken
@@ -0,0 +1,81 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SBKCOPY_H
+#define SBKCOPY_H
+
+#include <Python.h>
+#include <new>
+#include "shibokenmacros.h"
+
+struct SbkObject;
+struct SbkObjectType;
+
+namespace Shiboken
+{
+
+/// Copies of value type wrappers made with the C++ copy constructor.
+namespace Copy
+{
+
+/**
+ *  Copy constructs a new C++ object from the object at \p source, at \p storage if it isn't
+ *  null or in the heap otherwise, and returns its address.
+ */
+typedef void* (*CopyFunction)(const void* source, void* storage);
+
+/// Copy function for the C++ type T.
+template <typename T>
+void* copyObject(const void* source, void* storage)
+{
+    const T& object = *reinterpret_cast<const T*>(source);
+    return storage ? new (storage) T(object) : new T(object);
+}
+
+/**
+ *  Creates the C++ object of the wrapper \p self, just allocated by the tp_new of a subtype of
+ *  \p type, as a copy of the C++ object at \p source. Returns false with a Python error set if
+ *  it fails.
+ */
+LIBSHIBOKEN_API bool initialize(SbkObject* self, SbkObjectType* type, const void* source, CopyFunction copy);
+
+/**
+ *  Implements __deepcopy__ for the wrapper \p self of a C++ object of \p type. The copy keeps
+ *  the Python subclass of \p self, unless its C++ object has a C++ wrapper, and a deep copy of
+ *  its instance dictionary. It is recorded in the \p memo dictionary before copying the
+ *  instance dictionary, so that references back to \p self give the copy.
+ */
+LIBSHIBOKEN_API PyObject* deepCopy(PyObject* self, PyObject* memo, SbkObjectType* type, CopyFunction copy);
+
+/**
+ *  Returns a new list with copies of all the wrappers of C++ objects of \p type in \p sequence,
+ *  made without going through the Python copy machinery for each item. Instances of subtypes
+ *  are copied with copy.deepcopy, to keep their class and attributes.
+ */
+LIBSHIBOKEN_API PyObject* copyList(PyObject* sequence, SbkObjectType* type, CopyFunction copy);
+
+} // namespace Copy
+
+} // namespace Shiboken
+
+#endif // SBKCOPY_H
+
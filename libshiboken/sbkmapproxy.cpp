@@ -0,0 +1,325 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "sbkmapproxy.h"
+#include "autodecref.h"
+
+extern "C"
+{
+
+struct SbkMapProxy
+{
+    PyObject_HEAD
+    Shiboken::MapProxy::Map* map;
+};
+
+static inline Shiboken::MapProxy::Map* mapOf(PyObject* self)
+{
+    return reinterpret_cast<SbkMapProxy*>(self)->map;
+}
+
+static void SbkMapProxy_dealloc(PyObject* self)
+{
+    delete mapOf(self);
+    PyObject_Del(self);
+}
+
+static Py_ssize_t SbkMapProxy_length(PyObject* self)
+{
+    return mapOf(self)->size();
+}
+
+static PyObject* SbkMapProxy_subscript(PyObject* self, PyObject* key)
+{
+    PyObject* value = mapOf(self)->value(key);
+    if (!value && !PyErr_Occurred())
+        PyErr_SetObject(PyExc_KeyError, key);
+    return value;
+}
+
+static int SbkMapProxy_contains(PyObject* self, PyObject* key)
+{
+    bool found = mapOf(self)->contains(key);
+    if (PyErr_Occurred())
+        return -1;
+    return found;
+}
+
+struct SbkMapProxyIterator
+{
+    PyObject_HEAD
+    PyObject* proxy;
+    Shiboken::MapProxy::Map::KeyIterator* keys;
+};
+
+static void SbkMapProxyIterator_dealloc(PyObject* self)
+{
+    SbkMapProxyIterator* iterator = reinterpret_cast<SbkMapProxyIterator*>(self);
+    delete iterator->keys;
+    Py_DECREF(iterator->proxy);
+    PyObject_Del(self);
+}
+
+static PyObject* SbkMapProxyIterator_next(PyObject* self)
+{
+    return reinterpret_cast<SbkMapProxyIterator*>(self)->keys->next();
+}
+
+PyTypeObject SbkMapProxyIterator_Type = {
+    PyObject_HEAD_INIT(0)
+    /*ob_size*/             0,
+    /*tp_name*/             "Shiboken.MapProxyIterator",
+    /*tp_basicsize*/        sizeof(SbkMapProxyIterator),
+    /*tp_itemsize*/         0,
+    /*tp_dealloc*/          SbkMapProxyIterator_dealloc,
+    /*tp_print*/            0,
+    /*tp_getattr*/          0,
+    /*tp_setattr*/          0,
+    /*tp_compare*/          0,
+    /*tp_repr*/             0,
+    /*tp_as_number*/        0,
+    /*tp_as_sequence*/      0,
+    /*tp_as_mapping*/       0,
+    /*tp_hash*/             0,
+    /*tp_call*/             0,
+    /*tp_str*/              0,
+    /*tp_getattro*/         0,
+    /*tp_setattro*/         0,
+    /*tp_as_buffer*/        0,
+    /*tp_flags*/            Py_TPFLAGS_DEFAULT,
+    /*tp_doc*/              "Iterator over the keys of a map proxy, converted one at a time.",
+    /*tp_traverse*/         0,
+    /*tp_clear*/            0,
+    /*tp_richcompare*/      0,
+    /*tp_weaklistoffset*/   0,
+    /*tp_iter*/             PyObject_SelfIter,
+    /*tp_iternext*/         SbkMapProxyIterator_next,
+    /*tp_methods*/          0,
+    /*tp_members*/          0,
+    /*tp_getset*/           0,
+    /*tp_base*/             0,
+    /*tp_dict*/             0,
+    /*tp_descr_get*/        0,
+    /*tp_descr_set*/        0,
+    /*tp_dictoffset*/       0,
+    /*tp_init*/             0,
+    /*tp_alloc*/            0,
+    /*tp_new*/              0,
+    /*tp_free*/             0,
+    /*tp_is_gc*/            0,
+    /*tp_bases*/            0,
+    /*tp_mro*/              0,
+    /*tp_cache*/            0,
+    /*tp_subclasses*/       0,
+    /*tp_weaklist*/         0
+};
+
+static PyObject* SbkMapProxy_iter(PyObject* self)
+{
+    SbkMapProxyIterator* iterator = PyObject_New(SbkMapProxyIterator, &SbkMapProxyIterator_Type);
+    if (!iterator)
+        return 0;
+    Py_INCREF(self);
+    iterator->proxy = self;
+    iterator->keys = mapOf(self)->newKeyIterator();
+    return reinterpret_cast<PyObject*>(iterator);
+}
+
+static PyObject* SbkMapProxy_keys(PyObject* self)
+{
+    return mapOf(self)->keys();
+}
+
+static PyObject* SbkMapProxy_values(PyObject* self)
+{
+    return mapOf(self)->values();
+}
+
+static PyObject* SbkMapProxy_items(PyObject* self)
+{
+    return mapOf(self)->items();
+}
+
+static PyObject* SbkMapProxy_copy(PyObject* self)
+{
+    return Shiboken::MapProxy::toDict(self);
+}
+
+static PyObject* SbkMapProxy_has_key(PyObject* self, PyObject* key)
+{
+    int found = SbkMapProxy_contains(self, key);
+    if (found < 0)
+        return 0;
+    return PyBool_FromLong(found);
+}
+
+static PyObject* SbkMapProxy_get(PyObject* self, PyObject* args)
+{
+    PyObject* key;
+    PyObject* defaultValue = Py_None;
+    if (!PyArg_UnpackTuple(args, "get", 1, 2, &key, &defaultValue))
+        return 0;
+    PyObject* value = mapOf(self)->value(key);
+    if (!value && !PyErr_Occurred()) {
+        Py_INCREF(defaultValue);
+        return defaultValue;
+    }
+    return value;
+}
+
+static PyObject* SbkMapProxy_repr(PyObject* self)
+{
+    Shiboken::AutoDecRef dict(Shiboken::MapProxy::toDict(self));
+    if (dict.isNull())
+        return 0;
+    return PyObject_Repr(dict);
+}
+
+static PyObject* SbkMapProxy_richcompare(PyObject* self, PyObject* other, int op)
+{
+    if ((op != Py_EQ && op != Py_NE) || !(PyDict_Check(other) || Shiboken::MapProxy::check(other))) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+    Shiboken::AutoDecRef dict(Shiboken::MapProxy::toDict(self));
+    Shiboken::AutoDecRef otherDict(Shiboken::MapProxy::check(other) ? Shiboken::MapProxy::toDict(other) : (Py_INCREF(other), other));
+    if (dict.isNull() || otherDict.isNull())
+        return 0;
+    return PyObject_RichCompare(dict, otherDict, op);
+}
+
+static PyMappingMethods SbkMapProxy_as_mapping = {
+    /*mp_length*/           SbkMapProxy_length,
+    /*mp_subscript*/        SbkMapProxy_subscript,
+    /*mp_ass_subscript*/    0
+};
+
+static PySequenceMethods SbkMapProxy_as_sequence = {
+    /*sq_length*/           0,
+    /*sq_concat*/           0,
+    /*sq_repeat*/           0,
+    /*sq_item*/             0,
+    /*sq_slice*/            0,
+    /*sq_ass_item*/         0,
+    /*sq_ass_slice*/        0,
+    /*sq_contains*/         SbkMapProxy_contains
+};
+
+static PyMethodDef SbkMapProxy_methods[] = {
+    {"keys", (PyCFunction)SbkMapProxy_keys, METH_NOARGS},
+    {"values", (PyCFunction)SbkMapProxy_values, METH_NOARGS},
+    {"items", (PyCFunction)SbkMapProxy_items, METH_NOARGS},
+    {"copy", (PyCFunction)SbkMapProxy_copy, METH_NOARGS},
+    {"has_key", (PyCFunction)SbkMapProxy_has_key, METH_O},
+    {"get", (PyCFunction)SbkMapProxy_get, METH_VARARGS},
+    {0} // Sentinel
+};
+
+PyTypeObject SbkMapProxy_Type = {
+    PyObject_HEAD_INIT(0)
+    /*ob_size*/             0,
+    /*tp_name*/             "Shiboken.MapProxy",
+    /*tp_basicsize*/        sizeof(SbkMapProxy),
+    /*tp_itemsize*/         0,
+    /*tp_dealloc*/          SbkMapProxy_dealloc,
+    /*tp_print*/            0,
+    /*tp_getattr*/          0,
+    /*tp_setattr*/          0,
+    /*tp_compare*/          0,
+    /*tp_repr*/             SbkMapProxy_repr,
+    /*tp_as_number*/        0,
+    /*tp_as_sequence*/      &SbkMapProxy_as_sequence,
+    /*tp_as_mapping*/       &SbkMapProxy_as_mapping,
+    /*tp_hash*/             0,
+    /*tp_call*/             0,
+    /*tp_str*/              0,
+    /*tp_getattro*/         0,
+    /*tp_setattro*/         0,
+    /*tp_as_buffer*/        0,
+    /*tp_flags*/            Py_TPFLAGS_DEFAULT,
+    /*tp_doc*/              "Read only mapping that converts the items of a C++ map on access.",
+    /*tp_traverse*/         0,
+    /*tp_clear*/            0,
+    /*tp_richcompare*/      SbkMapProxy_richcompare,
+    /*tp_weaklistoffset*/   0,
+    /*tp_iter*/             SbkMapProxy_iter,
+    /*tp_iternext*/         0,
+    /*tp_methods*/          SbkMapProxy_methods,
+    /*tp_members*/          0,
+    /*tp_getset*/           0,
+    /*tp_base*/             0,
+    /*tp_dict*/             0,
+    /*tp_descr_get*/        0,
+    /*tp_descr_set*/        0,
+    /*tp_dictoffset*/       0,
+    /*tp_init*/             0,
+    /*tp_alloc*/            0,
+    /*tp_new*/              0,
+    /*tp_free*/             0,
+    /*tp_is_gc*/            0,
+    /*tp_bases*/            0,
+    /*tp_mro*/              0,
+    /*tp_cache*/            0,
+    /*tp_subclasses*/       0,
+    /*tp_weaklist*/         0
+};
+
+} // extern "C"
+
+namespace Shiboken
+{
+namespace MapProxy
+{
+
+PyObject* newObject(Map* map)
+{
+    SbkMapProxy* self = PyObject_New(SbkMapProxy, &SbkMapProxy_Type);
+    if (!self) {
+        delete map;
+        return 0;
+    }
+    self->map = map;
+    return reinterpret_cast<PyObject*>(self);
+}
+
+bool check(PyObject* pyObj)
+{
+    return PyObject_TypeCheck(pyObj, &SbkMapProxy_Type);
+}
+
+PyObject* toDict(PyObject* pyObj)
+{
+    AutoDecRef items(mapOf(pyObj)->items());
+    PyObject* result = PyDict_New();
+    for (Py_ssize_t i = 0, max = PyList_GET_SIZE(items.object()); i < max; ++i) {
+        PyObject* item = PyList_GET_ITEM(items.object(), i);
+        if (PyDict_SetItem(result, PyTuple_GET_ITEM(item, 0), PyTuple_GET_ITEM(item, 1)) < 0) {
+            Py_DECREF(result);
+            return 0;
+        }
+    }
+    return result;
+}
+
+} // namespace MapProxy
+} // namespace Shiboken
+
@@ -0,0 +1,189 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SBKMAPPROXY_H
+#define SBKMAPPROXY_H
+
+#include <Python.h>
+#include "shibokenmacros.h"
+#include "conversions.h"
+
+extern "C"
+{
+
+extern LIBSHIBOKEN_API PyTypeObject SbkMapProxy_Type;
+extern LIBSHIBOKEN_API PyTypeObject SbkMapProxyIterator_Type;
+
+} // extern "C"
+
+namespace Shiboken
+{
+namespace MapProxy
+{
+
+/**
+ *  C++ map owned by a map proxy, the keys and values are converted to Python only when they
+ *  are accessed. Shiboken::LazyMap implements it for the std::map like containers.
+ */
+class LIBSHIBOKEN_API Map
+{
+public:
+    /// Cursor over the keys of a map, used by the iterators of map proxies.
+    class KeyIterator
+    {
+    public:
+        virtual ~KeyIterator() {}
+        /// Returns a new reference to the next converted key, or 0 when there are no more keys.
+        virtual PyObject* next() = 0;
+    };
+
+    virtual ~Map() {}
+    virtual Py_ssize_t size() const = 0;
+    /**
+     *  Returns a new reference to the value mapped to \p key, or 0 if there is no such key.
+     *  Keys that can't be converted to the C++ key type are not found.
+     */
+    virtual PyObject* value(PyObject* key) = 0;
+    virtual bool contains(PyObject* key) = 0;
+    /// Returns a new list with the converted keys.
+    virtual PyObject* keys() = 0;
+    /// Returns a new list with the converted values.
+    virtual PyObject* values() = 0;
+    /// Returns a new list with (key, value) tuples.
+    virtual PyObject* items() = 0;
+    /// Returns a new iterator over the keys, which converts each key when it is reached.
+    virtual KeyIterator* newKeyIterator() = 0;
+};
+
+/// Creates a Python mapping over \p map, taking its ownership.
+LIBSHIBOKEN_API PyObject* newObject(Map* map);
+/// Returns true if \p pyObj is a map proxy.
+LIBSHIBOKEN_API bool check(PyObject* pyObj);
+/// Returns a new dictionary with all the items of the map proxy \p pyObj.
+LIBSHIBOKEN_API PyObject* toDict(PyObject* pyObj);
+
+} // namespace MapProxy
+
+template <typename StdMap>
+class LazyMap : public MapProxy::Map
+{
+public:
+    typedef typename StdMap::key_type KeyType;
+    typedef typename StdMap::mapped_type MappedType;
+
+    /// Takes the contents of \p map, which is left empty.
+    explicit LazyMap(StdMap& map) { m_map.swap(map); }
+
+    Py_ssize_t size() const { return m_map.size(); }
+
+    PyObject* value(PyObject* key)
+    {
+        typename StdMap::const_iterator it = find(key);
+        if (it == m_map.end())
+            return 0;
+        return Converter<MappedType>::toPython(it->second);
+    }
+
+    bool contains(PyObject* key) { return find(key) != m_map.end(); }
+
+    PyObject* keys()
+    {
+        PyObject* result = PyList_New(m_map.size());
+        typename StdMap::const_iterator it = m_map.begin();
+        for (Py_ssize_t idx = 0; it != m_map.end(); ++it, ++idx)
+            PyList_SET_ITEM(result, idx, Converter<KeyType>::toPython(it->first));
+        return result;
+    }
+
+    PyObject* values()
+    {
+        PyObject* result = PyList_New(m_map.size());
+        typename StdMap::const_iterator it = m_map.begin();
+        for (Py_ssize_t idx = 0; it != m_map.end(); ++it, ++idx)
+            PyList_SET_ITEM(result, idx, Converter<MappedType>::toPython(it->second));
+        return result;
+    }
+
+    PyObject* items()
+    {
+        PyObject* result = PyList_New(m_map.size());
+        typename StdMap::const_iterator it = m_map.begin();
+        for (Py_ssize_t idx = 0; it != m_map.end(); ++it, ++idx) {
+            PyObject* item = PyTuple_New(2);
+            PyTuple_SET_ITEM(item, 0, Converter<KeyType>::toPython(it->first));
+            PyTuple_SET_ITEM(item, 1, Converter<MappedType>::toPython(it->second));
+            PyList_SET_ITEM(result, idx, item);
+        }
+        return result;
+    }
+
+    MapProxy::Map::KeyIterator* newKeyIterator() { return new LazyKeyIterator(m_map); }
+
+private:
+    class LazyKeyIterator : public MapProxy::Map::KeyIterator
+    {
+    public:
+        // The map is never modified, so the cursor stays valid while the map is alive.
+        explicit LazyKeyIterator(const StdMap& map) : m_cursor(map.begin()), m_end(map.end()) {}
+
+        PyObject* next()
+        {
+            if (m_cursor == m_end)
+                return 0;
+            return Converter<KeyType>::toPython((m_cursor++)->first);
+        }
+
+    private:
+        typename StdMap::const_iterator m_cursor;
+        typename StdMap::const_iterator m_end;
+    };
+
+    typename StdMap::const_iterator find(PyObject* key) const
+    {
+        if (!Converter<KeyType>::isConvertible(key))
+            return m_map.end();
+        KeyType cppKey(Converter<KeyType>::toCpp(key));
+        // As for a dictionary, a key that can't be converted is just not in the map.
+        if (PyErr_Occurred()) {
+            PyErr_Clear();
+            return m_map.end();
+        }
+        return m_map.find(cppKey);
+    }
+
+    StdMap m_map;
+};
+
+/**
+ *  Returns a Python mapping that takes the contents of \p map, converting its keys and
+ *  values only when they are accessed. \p map is left empty.
+ */
+template <typename StdMap>
+inline PyObject* createMapProxy(StdMap& map)
+{
+    return MapProxy::newObject(new LazyMap<StdMap>(map));
+}
+
+} // namespace Shiboken
+
+#endif // SBKMAPPROXY_H
+
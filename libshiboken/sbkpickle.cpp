@@ -0,0 +1,188 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "sbkpickle.h"
+#include <cstring>
+#include "basewrapper.h"
+#include "autodecref.h"
+
+namespace Shiboken
+{
+
+namespace Pickle
+{
+
+static PyObject* newObjectFunction()
+{
+    static PyObject* newObj = 0;
+    if (!newObj) {
+        AutoDecRef copyReg(PyImport_ImportModule("copy_reg"));
+        if (copyReg.isNull())
+            return 0;
+        newObj = PyObject_GetAttrString(copyReg, "__newobj__");
+    }
+    return newObj;
+}
+
+static bool checkBytes(PyObject* data, size_t size, bool multiple)
+{
+    if (!PyString_Check(data)) {
+        PyErr_Format(PyExc_TypeError, "expected a string, got '%s'", data->ob_type->tp_name);
+        return false;
+    }
+    size_t dataSize = PyString_GET_SIZE(data);
+    if (multiple ? dataSize % size != 0 : dataSize != size) {
+        PyErr_Format(PyExc_ValueError, "invalid size of the pickled state: %lu bytes",
+                     static_cast<unsigned long>(dataSize));
+        return false;
+    }
+    return true;
+}
+
+PyObject* reduce(PyObject* self, SbkObjectType* type, size_t size)
+{
+    SbkObject* sbkSelf = reinterpret_cast<SbkObject*>(self);
+    if (!Object::isValid(sbkSelf))
+        return 0;
+    PyObject* newObj = newObjectFunction();
+    if (!newObj)
+        return 0;
+
+    void* cptr = Object::cppPointer(sbkSelf, reinterpret_cast<PyTypeObject*>(type));
+    AutoDecRef state(PyString_FromStringAndSize(reinterpret_cast<const char*>(cptr), size));
+    if (state.isNull())
+        return 0;
+    if (sbkSelf->ob_dict && PyDict_Size(sbkSelf->ob_dict) > 0) {
+        state = Py_BuildValue("(OO)", state.object(), sbkSelf->ob_dict);
+        if (state.isNull())
+            return 0;
+    }
+    return Py_BuildValue("(O(O)O)", newObj, self->ob_type, state.object());
+}
+
+PyObject* setState(PyObject* self, PyObject* state, SbkObjectType* type, size_t size, Copy::CopyFunction copy)
+{
+    SbkObject* sbkSelf = reinterpret_cast<SbkObject*>(self);
+    PyObject* bytes = state;
+    PyObject* dict = 0;
+    if (PyTuple_Check(state) && PyTuple_GET_SIZE(state) == 2) {
+        bytes = PyTuple_GET_ITEM(state, 0);
+        dict = PyTuple_GET_ITEM(state, 1);
+    }
+    if (!checkBytes(bytes, size, false))
+        return 0;
+    if (dict && !PyDict_Check(dict)) {
+        PyErr_SetString(PyExc_TypeError, "the instance dictionary of the pickled state must be a dict");
+        return 0;
+    }
+
+    void* cptr = Object::cppPointer(sbkSelf, reinterpret_cast<PyTypeObject*>(type));
+    if (cptr) {
+        if (!Object::isValid(sbkSelf))
+            return 0;
+        std::memcpy(cptr, PyString_AS_STRING(bytes), size);
+    } else {
+        // The string buffer has no alignment guarantees for the C++ type.
+        void* source = PyMem_Malloc(size);
+        if (!source)
+            return PyErr_NoMemory();
+        std::memcpy(source, PyString_AS_STRING(bytes), size);
+        bool ok = Copy::initialize(sbkSelf, type, source, copy);
+        PyMem_Free(source);
+        if (!ok)
+            return 0;
+    }
+
+    if (dict) {
+        if (!sbkSelf->ob_dict)
+            sbkSelf->ob_dict = PyDict_New();
+        if (!sbkSelf->ob_dict || PyDict_Update(sbkSelf->ob_dict, dict) < 0)
+            return 0;
+    }
+    Py_RETURN_NONE;
+}
+
+PyObject* packList(PyObject* sequence, SbkObjectType* type, size_t size)
+{
+    PyTypeObject* pyType = reinterpret_cast<PyTypeObject*>(type);
+    AutoDecRef fastSequence(PySequence_Fast(sequence, "expected a sequence"));
+    if (fastSequence.isNull())
+        return 0;
+    Py_ssize_t count = PySequence_Fast_GET_SIZE(fastSequence.object());
+    PyObject** items = PySequence_Fast_ITEMS(fastSequence.object());
+
+    PyObject* result = PyString_FromStringAndSize(0, count * size);
+    if (!result)
+        return 0;
+    char* data = PyString_AS_STRING(result);
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        if (!PyObject_TypeCheck(items[i], pyType)) {
+            PyErr_Format(PyExc_TypeError, "expected '%s' items, got '%s'", pyType->tp_name, items[i]->ob_type->tp_name);
+            Py_DECREF(result);
+            return 0;
+        }
+        SbkObject* item = reinterpret_cast<SbkObject*>(items[i]);
+        if (!Object::isValid(item)) {
+            Py_DECREF(result);
+            return 0;
+        }
+        std::memcpy(data + i * size, Object::cppPointer(item, pyType), size);
+    }
+    return result;
+}
+
+PyObject* unpackList(PyObject* data, SbkObjectType* type, size_t size, Copy::CopyFunction copy)
+{
+    if (!checkBytes(data, size, true))
+        return 0;
+    Py_ssize_t count = PyString_GET_SIZE(data) / size;
+    PyObject* result = PyList_New(count);
+    if (!result || count == 0)
+        return result;
+
+    // One aligned copy of all the objects serves as source for the copy constructors.
+    void* sources = PyMem_Malloc(PyString_GET_SIZE(data));
+    if (!sources) {
+        Py_DECREF(result);
+        return PyErr_NoMemory();
+    }
+    std::memcpy(sources, PyString_AS_STRING(data), PyString_GET_SIZE(data));
+
+    PyTypeObject* pyType = reinterpret_cast<PyTypeObject*>(type);
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        PyObject* item = pyType->tp_new(pyType, 0, 0);
+        if (item) {
+            PyList_SET_ITEM(result, i, item);
+            if (Copy::initialize(reinterpret_cast<SbkObject*>(item), type, reinterpret_cast<char*>(sources) + i * size, copy))
+                continue;
+        }
+        PyMem_Free(sources);
+        Py_DECREF(result);
+        return 0;
+    }
+    PyMem_Free(sources);
+    return result;
+}
+
+} // namespace Pickle
+
+} // namespace Shiboken
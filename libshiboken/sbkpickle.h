@@ -0,0 +1,66 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SBKPICKLE_H
+#define SBKPICKLE_H
+
+#include <Python.h>
+#include "shibokenmacros.h"
+#include "sbkcopy.h"
+
+struct SbkObjectType;
+
+namespace Shiboken
+{
+
+/**
+ *  Pickling of value types whose C++ objects are trivially copyable, i.e. fully described by
+ *  the bytes of their memory. The state of a pickled object is the string with those bytes.
+ */
+namespace Pickle
+{
+
+/**
+ *  Implements __reduce__ for the wrapper \p self of a C++ object of \p type, which has \p size
+ *  bytes. The object is recreated without calling its constructor, and its bytes restored by
+ *  __setstate__, along with the instance dictionary of Python subclasses.
+ */
+LIBSHIBOKEN_API PyObject* reduce(PyObject* self, SbkObjectType* type, size_t size);
+
+/**
+ *  Implements __setstate__ for the wrapper \p self. The bytes in \p state are copied over the
+ *  C++ object, or used to create it with \p copy if \p self was just created by __reduce__.
+ */
+LIBSHIBOKEN_API PyObject* setState(PyObject* self, PyObject* state, SbkObjectType* type, size_t size, Copy::CopyFunction copy);
+
+/// Returns a string with the bytes of the C++ objects of all the wrappers in \p sequence.
+LIBSHIBOKEN_API PyObject* packList(PyObject* sequence, SbkObjectType* type, size_t size);
+
+/// Returns a list with new wrappers for the C++ objects whose bytes are in the string \p data.
+LIBSHIBOKEN_API PyObject* unpackList(PyObject* data, SbkObjectType* type, size_t size, Copy::CopyFunction copy);
+
+} // namespace Pickle
+
+} // namespace Shiboken
+
+#endif // SBKPICKLE_H
+
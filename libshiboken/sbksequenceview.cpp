@@ -0,0 +1,192 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "sbksequenceview.h"
+#include "autodecref.h"
+
+extern "C"
+{
+
+struct SbkSequenceView
+{
+    PyObject_HEAD
+    Shiboken::SequenceView::Sequence* sequence;
+};
+
+static inline Shiboken::SequenceView::Sequence* sequenceOf(PyObject* self)
+{
+    return reinterpret_cast<SbkSequenceView*>(self)->sequence;
+}
+
+static void SbkSequenceView_dealloc(PyObject* self)
+{
+    delete sequenceOf(self);
+    PyObject_Del(self);
+}
+
+static Py_ssize_t SbkSequenceView_length(PyObject* self)
+{
+    return sequenceOf(self)->size();
+}
+
+static PyObject* SbkSequenceView_item(PyObject* self, Py_ssize_t index)
+{
+    if (index < 0 || index >= sequenceOf(self)->size()) {
+        PyErr_SetString(PyExc_IndexError, "sequence index out of range");
+        return 0;
+    }
+    return sequenceOf(self)->item(index);
+}
+
+static PyObject* SbkSequenceView_slice(PyObject* self, Py_ssize_t begin, Py_ssize_t end)
+{
+    Py_ssize_t size = sequenceOf(self)->size();
+    if (begin < 0)
+        begin = 0;
+    if (end > size)
+        end = size;
+    if (end < begin)
+        end = begin;
+
+    PyObject* result = PyList_New(end - begin);
+    for (Py_ssize_t i = begin; i < end; ++i) {
+        PyObject* item = sequenceOf(self)->item(i);
+        if (!item) {
+            Py_DECREF(result);
+            return 0;
+        }
+        PyList_SET_ITEM(result, i - begin, item);
+    }
+    return result;
+}
+
+static PyObject* SbkSequenceView_repr(PyObject* self)
+{
+    Shiboken::AutoDecRef list(Shiboken::SequenceView::toList(self));
+    if (list.isNull())
+        return 0;
+    return PyObject_Repr(list);
+}
+
+static PyObject* SbkSequenceView_richcompare(PyObject* self, PyObject* other, int op)
+{
+    if (!(PyList_Check(other) || Shiboken::SequenceView::check(other))) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+    Shiboken::AutoDecRef list(Shiboken::SequenceView::toList(self));
+    Shiboken::AutoDecRef otherList(Shiboken::SequenceView::check(other) ? Shiboken::SequenceView::toList(other) : (Py_INCREF(other), other));
+    if (list.isNull() || otherList.isNull())
+        return 0;
+    return PyObject_RichCompare(list, otherList, op);
+}
+
+static PySequenceMethods SbkSequenceView_as_sequence = {
+    /*sq_length*/           SbkSequenceView_length,
+    /*sq_concat*/           0,
+    /*sq_repeat*/           0,
+    /*sq_item*/             SbkSequenceView_item,
+    /*sq_slice*/            SbkSequenceView_slice,
+    /*sq_ass_item*/         0,
+    /*sq_ass_slice*/        0,
+    /*sq_contains*/         0
+};
+
+PyTypeObject SbkSequenceView_Type = {
+    PyObject_HEAD_INIT(0)
+    /*ob_size*/             0,
+    /*tp_name*/             "Shiboken.SequenceView",
+    /*tp_basicsize*/        sizeof(SbkSequenceView),
+    /*tp_itemsize*/         0,
+    /*tp_dealloc*/          SbkSequenceView_dealloc,
+    /*tp_print*/            0,
+    /*tp_getattr*/          0,
+    /*tp_setattr*/          0,
+    /*tp_compare*/          0,
+    /*tp_repr*/             SbkSequenceView_repr,
+    /*tp_as_number*/        0,
+    /*tp_as_sequence*/      &SbkSequenceView_as_sequence,
+    /*tp_as_mapping*/       0,
+    /*tp_hash*/             0,
+    /*tp_call*/             0,
+    /*tp_str*/              0,
+    /*tp_getattro*/         0,
+    /*tp_setattro*/         0,
+    /*tp_as_buffer*/        0,
+    /*tp_flags*/            Py_TPFLAGS_DEFAULT,
+    /*tp_doc*/              "Read only sequence that converts the items of a C++ container on access.",
+    /*tp_traverse*/         0,
+    /*tp_clear*/            0,
+    /*tp_richcompare*/      SbkSequenceView_richcompare,
+    /*tp_weaklistoffset*/   0,
+    /*tp_iter*/             0,
+    /*tp_iternext*/         0,
+    /*tp_methods*/          0,
+    /*tp_members*/          0,
+    /*tp_getset*/           0,
+    /*tp_base*/             0,
+    /*tp_dict*/             0,
+    /*tp_descr_get*/        0,
+    /*tp_descr_set*/        0,
+    /*tp_dictoffset*/       0,
+    /*tp_init*/             0,
+    /*tp_alloc*/            0,
+    /*tp_new*/              0,
+    /*tp_free*/             0,
+    /*tp_is_gc*/            0,
+    /*tp_bases*/            0,
+    /*tp_mro*/              0,
+    /*tp_cache*/            0,
+    /*tp_subclasses*/       0,
+    /*tp_weaklist*/         0
+};
+
+} // extern "C"
+
+namespace Shiboken
+{
+namespace SequenceView
+{
+
+PyObject* newObject(Sequence* sequence)
+{
+    SbkSequenceView* self = PyObject_New(SbkSequenceView, &SbkSequenceView_Type);
+    if (!self) {
+        delete sequence;
+        return 0;
+    }
+    self->sequence = sequence;
+    return reinterpret_cast<PyObject*>(self);
+}
+
+bool check(PyObject* pyObj)
+{
+    return PyObject_TypeCheck(pyObj, &SbkSequenceView_Type);
+}
+
+PyObject* toList(PyObject* pyObj)
+{
+    return SbkSequenceView_slice(pyObj, 0, sequenceOf(pyObj)->size());
+}
+
+} // namespace SequenceView
+} // namespace Shiboken
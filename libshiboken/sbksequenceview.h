@@ -0,0 +1,106 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SBKSEQUENCEVIEW_H
+#define SBKSEQUENCEVIEW_H
+
+#include <Python.h>
+#include <iterator>
+#include "shibokenmacros.h"
+#include "conversions.h"
+
+extern "C"
+{
+
+extern LIBSHIBOKEN_API PyTypeObject SbkSequenceView_Type;
+
+} // extern "C"
+
+namespace Shiboken
+{
+namespace SequenceView
+{
+
+/**
+ *  C++ container owned by a sequence view, its items are converted to Python only when they
+ *  are accessed. Shiboken::LazySequence implements it for the std::list like containers.
+ */
+class LIBSHIBOKEN_API Sequence
+{
+public:
+    virtual ~Sequence() {}
+    virtual Py_ssize_t size() const = 0;
+    /// Returns a new reference to the item at \p index, which must be inside the sequence bounds.
+    virtual PyObject* item(Py_ssize_t index) = 0;
+};
+
+/// Creates a Python sequence over \p sequence, taking its ownership.
+LIBSHIBOKEN_API PyObject* newObject(Sequence* sequence);
+/// Returns true if \p pyObj is a sequence view.
+LIBSHIBOKEN_API bool check(PyObject* pyObj);
+/// Returns a new list with all the items of the sequence view \p pyObj.
+LIBSHIBOKEN_API PyObject* toList(PyObject* pyObj);
+
+} // namespace SequenceView
+
+template <typename StdList>
+class LazySequence : public SequenceView::Sequence
+{
+public:
+    typedef typename StdList::value_type ValueType;
+
+    /// Takes the contents of \p list, which is left empty.
+    explicit LazySequence(StdList& list) : m_cursorIndex(0)
+    {
+        m_list.swap(list);
+        m_cursor = m_list.begin();
+    }
+
+    Py_ssize_t size() const { return m_list.size(); }
+
+    PyObject* item(Py_ssize_t index)
+    {
+        // Moving from the last accessed position makes the sequential access to lists linear.
+        std::advance(m_cursor, index - m_cursorIndex);
+        m_cursorIndex = index;
+        return Converter<ValueType>::toPython(*m_cursor);
+    }
+
+private:
+    StdList m_list;
+    typename StdList::const_iterator m_cursor;
+    Py_ssize_t m_cursorIndex;
+};
+
+/**
+ *  Returns a Python sequence that takes the contents of \p list, converting its items only
+ *  when they are accessed. \p list is left empty.
+ */
+template <typename StdList>
+inline PyObject* createSequenceView(StdList& list)
+{
+    return SequenceView::newObject(new LazySequence<StdList>(list));
+}
+
+} // namespace Shiboken
+
+#endif // SBKSEQUENCEVIEW_H
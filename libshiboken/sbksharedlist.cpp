@@ -0,0 +1,238 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "sbksharedlist.h"
+#include "autodecref.h"
+
+extern "C"
+{
+
+struct SbkSharedList
+{
+    PyObject_HEAD
+    Shiboken::SharedList::List* list;
+};
+
+static inline Shiboken::SharedList::List* listOf(PyObject* self)
+{
+    return reinterpret_cast<SbkSharedList*>(self)->list;
+}
+
+static inline bool checkIndex(PyObject* self, Py_ssize_t index)
+{
+    if (index < 0 || index >= listOf(self)->size()) {
+        PyErr_SetString(PyExc_IndexError, "list index out of range");
+        return false;
+    }
+    return true;
+}
+
+static void SbkSharedList_dealloc(PyObject* self)
+{
+    delete listOf(self);
+    PyObject_Del(self);
+}
+
+static Py_ssize_t SbkSharedList_length(PyObject* self)
+{
+    return listOf(self)->size();
+}
+
+static PyObject* SbkSharedList_item(PyObject* self, Py_ssize_t index)
+{
+    if (!checkIndex(self, index))
+        return 0;
+    return listOf(self)->item(index);
+}
+
+static int SbkSharedList_ass_item(PyObject* self, Py_ssize_t index, PyObject* value)
+{
+    if (!value) {
+        PyErr_SetString(PyExc_TypeError, "items can't be removed from a shared list");
+        return -1;
+    }
+    if (!checkIndex(self, index))
+        return -1;
+    return listOf(self)->setItem(index, value) ? 0 : -1;
+}
+
+static PyObject* SbkSharedList_append(PyObject* self, PyObject* value)
+{
+    if (!listOf(self)->append(value))
+        return 0;
+    Py_RETURN_NONE;
+}
+
+static PyObject* SbkSharedList_extend(PyObject* self, PyObject* values)
+{
+    Shiboken::AutoDecRef fastSequence(PySequence_Fast(values, "Sequence expected."));
+    if (fastSequence.isNull())
+        return 0;
+    PyObject** items = PySequence_Fast_ITEMS(fastSequence.object());
+    for (Py_ssize_t i = 0, max = PySequence_Fast_GET_SIZE(fastSequence.object()); i < max; ++i) {
+        if (!listOf(self)->append(items[i]))
+            return 0;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* SbkSharedList_clear(PyObject* self)
+{
+    listOf(self)->clear();
+    Py_RETURN_NONE;
+}
+
+static PyObject* SbkSharedList_repr(PyObject* self)
+{
+    Shiboken::AutoDecRef list(Shiboken::SharedList::toList(self));
+    if (list.isNull())
+        return 0;
+    return PyObject_Repr(list);
+}
+
+static PyObject* SbkSharedList_richcompare(PyObject* self, PyObject* other, int op)
+{
+    if (!(PyList_Check(other) || Shiboken::SharedList::check(other))) {
+        Py_INCREF(Py_NotImplemented);
+        return Py_NotImplemented;
+    }
+    Shiboken::AutoDecRef list(Shiboken::SharedList::toList(self));
+    Shiboken::AutoDecRef otherList(Shiboken::SharedList::check(other) ? Shiboken::SharedList::toList(other) : (Py_INCREF(other), other));
+    if (list.isNull() || otherList.isNull())
+        return 0;
+    return PyObject_RichCompare(list, otherList, op);
+}
+
+static PySequenceMethods SbkSharedList_as_sequence = {
+    /*sq_length*/           SbkSharedList_length,
+    /*sq_concat*/           0,
+    /*sq_repeat*/           0,
+    /*sq_item*/             SbkSharedList_item,
+    /*sq_slice*/            0,
+    /*sq_ass_item*/         SbkSharedList_ass_item,
+    /*sq_ass_slice*/        0,
+    /*sq_contains*/         0
+};
+
+static PyMethodDef SbkSharedList_methods[] = {
+    {"append", (PyCFunction)SbkSharedList_append, METH_O},
+    {"extend", (PyCFunction)SbkSharedList_extend, METH_O},
+    {"clear", (PyCFunction)SbkSharedList_clear, METH_NOARGS},
+    {0} // Sentinel
+};
+
+PyTypeObject SbkSharedList_Type = {
+    PyObject_HEAD_INIT(0)
+    /*ob_size*/             0,
+    /*tp_name*/             "Shiboken.SharedList",
+    /*tp_basicsize*/        sizeof(SbkSharedList),
+    /*tp_itemsize*/         0,
+    /*tp_dealloc*/          SbkSharedList_dealloc,
+    /*tp_print*/            0,
+    /*tp_getattr*/          0,
+    /*tp_setattr*/          0,
+    /*tp_compare*/          0,
+    /*tp_repr*/             SbkSharedList_repr,
+    /*tp_as_number*/        0,
+    /*tp_as_sequence*/      &SbkSharedList_as_sequence,
+    /*tp_as_mapping*/       0,
+    /*tp_hash*/             0,
+    /*tp_call*/             0,
+    /*tp_str*/              0,
+    /*tp_getattro*/         0,
+    /*tp_setattro*/         0,
+    /*tp_as_buffer*/        0,
+    /*tp_flags*/            Py_TPFLAGS_DEFAULT,
+    /*tp_doc*/              "List stored in a C++ container, which is passed by reference to C++ functions.",
+    /*tp_traverse*/         0,
+    /*tp_clear*/            0,
+    /*tp_richcompare*/      SbkSharedList_richcompare,
+    /*tp_weaklistoffset*/   0,
+    /*tp_iter*/             0,
+    /*tp_iternext*/         0,
+    /*tp_methods*/          SbkSharedList_methods,
+    /*tp_members*/          0,
+    /*tp_getset*/           0,
+    /*tp_base*/             0,
+    /*tp_dict*/             0,
+    /*tp_descr_get*/        0,
+    /*tp_descr_set*/        0,
+    /*tp_dictoffset*/       0,
+    /*tp_init*/             0,
+    /*tp_alloc*/            0,
+    /*tp_new*/              0,
+    /*tp_free*/             0,
+    /*tp_is_gc*/            0,
+    /*tp_bases*/            0,
+    /*tp_mro*/              0,
+    /*tp_cache*/            0,
+    /*tp_subclasses*/       0,
+    /*tp_weaklist*/         0
+};
+
+} // extern "C"
+
+namespace Shiboken
+{
+namespace SharedList
+{
+
+PyObject* newObject(List* list)
+{
+    SbkSharedList* self = PyObject_New(SbkSharedList, &SbkSharedList_Type);
+    if (!self) {
+        delete list;
+        return 0;
+    }
+    self->list = list;
+    return reinterpret_cast<PyObject*>(self);
+}
+
+bool check(PyObject* pyObj)
+{
+    return PyObject_TypeCheck(pyObj, &SbkSharedList_Type);
+}
+
+void* cppPointer(PyObject* pyObj, const std::type_info& type)
+{
+    if (!check(pyObj) || listOf(pyObj)->type() != type)
+        return 0;
+    return listOf(pyObj)->data();
+}
+
+PyObject* toList(PyObject* pyObj)
+{
+    Py_ssize_t size = listOf(pyObj)->size();
+    PyObject* result = PyList_New(size);
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        PyObject* item = listOf(pyObj)->item(i);
+        if (!item) {
+            Py_DECREF(result);
+            return 0;
+        }
+        PyList_SET_ITEM(result, i, item);
+    }
+    return result;
+}
+
+} // namespace SharedList
+} // namespace Shiboken
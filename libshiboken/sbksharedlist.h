@@ -0,0 +1,207 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SBKSHAREDLIST_H
+#define SBKSHAREDLIST_H
+
+#include <Python.h>
+#include <algorithm>
+#include <iterator>
+#include <typeinfo>
+#include "shibokenmacros.h"
+
+extern "C"
+{
+
+extern LIBSHIBOKEN_API PyTypeObject SbkSharedList_Type;
+
+} // extern "C"
+
+namespace Shiboken
+{
+
+template <typename T> struct Converter;
+
+namespace SharedList
+{
+
+/**
+ *  C++ container owned by a shared list. Python code modifies it in place, and C++ functions
+ *  taking the same container type by reference receive it without copies.
+ *  Shiboken::SharedStdList implements it for the std::list like containers.
+ */
+class LIBSHIBOKEN_API List
+{
+public:
+    virtual ~List() {}
+    /// Type of the C++ container.
+    virtual const std::type_info& type() const = 0;
+    /// Returns the C++ container, which may be modified by the caller.
+    virtual void* data() = 0;
+    virtual Py_ssize_t size() const = 0;
+    /// Returns a new reference to the item at \p index, which must be inside the list bounds.
+    virtual PyObject* item(Py_ssize_t index) = 0;
+    /// Replaces the item at \p index, returns false and sets a Python error on failure.
+    virtual bool setItem(Py_ssize_t index, PyObject* value) = 0;
+    /// Appends \p value, returns false and sets a Python error on failure.
+    virtual bool append(PyObject* value) = 0;
+    virtual void clear() = 0;
+};
+
+/// Creates a Python sequence over \p list, taking its ownership.
+LIBSHIBOKEN_API PyObject* newObject(List* list);
+/// Returns true if \p pyObj is a shared list.
+LIBSHIBOKEN_API bool check(PyObject* pyObj);
+/// Returns the C++ container of the shared list \p pyObj if it has the given \p type, or 0 otherwise.
+LIBSHIBOKEN_API void* cppPointer(PyObject* pyObj, const std::type_info& type);
+/// Returns a new list with all the items of the shared list \p pyObj.
+LIBSHIBOKEN_API PyObject* toList(PyObject* pyObj);
+
+} // namespace SharedList
+
+template <typename StdList>
+class SharedStdList : public SharedList::List
+{
+public:
+    typedef typename StdList::value_type ValueType;
+
+    SharedStdList() : m_cursorIndex(-1) {}
+
+    const std::type_info& type() const { return typeid(StdList); }
+
+    void* data()
+    {
+        // The container may be changed behind our back from now on.
+        invalidateCursor();
+        return &m_list;
+    }
+
+    Py_ssize_t size() const { return m_list.size(); }
+
+    PyObject* item(Py_ssize_t index)
+    {
+        return Converter<ValueType>::toPython(*position(index));
+    }
+
+    bool setItem(Py_ssize_t index, PyObject* value)
+    {
+        if (!Converter<ValueType>::isConvertible(value)) {
+            PyErr_SetString(PyExc_TypeError, "invalid item type for this list");
+            return false;
+        }
+        ValueType cppValue(Converter<ValueType>::toCpp(value));
+        if (PyErr_Occurred())
+            return false;
+        *position(index) = cppValue;
+        return true;
+    }
+
+    bool append(PyObject* value)
+    {
+        if (!Converter<ValueType>::isConvertible(value)) {
+            PyErr_SetString(PyExc_TypeError, "invalid item type for this list");
+            return false;
+        }
+        ValueType cppValue(Converter<ValueType>::toCpp(value));
+        if (PyErr_Occurred())
+            return false;
+        m_list.push_back(cppValue);
+        invalidateCursor();
+        return true;
+    }
+
+    void clear()
+    {
+        m_list.clear();
+        invalidateCursor();
+    }
+
+private:
+    // Moving from the last accessed position makes the sequential access to lists linear.
+    typename StdList::iterator position(Py_ssize_t index)
+    {
+        if (m_cursorIndex < 0) {
+            m_cursor = m_list.begin();
+            m_cursorIndex = 0;
+        }
+        std::advance(m_cursor, index - m_cursorIndex);
+        m_cursorIndex = index;
+        return m_cursor;
+    }
+
+    // The cursor is moved back to the first item the next time it's needed.
+    void invalidateCursor() { m_cursorIndex = -1; }
+
+    StdList m_list;
+    typename StdList::iterator m_cursor;
+    Py_ssize_t m_cursorIndex;
+};
+
+/**
+ *  Returns a new shared list holding a C++ container of type StdList, filled with the items
+ *  of \p sequence if it isn't null. Returns 0 with a Python error set if \p sequence can't be
+ *  converted to StdList.
+ */
+template <typename StdList>
+PyObject* createSharedList(PyObject* sequence = 0)
+{
+    SharedStdList<StdList>* list = new SharedStdList<StdList>;
+    if (sequence && sequence != Py_None) {
+        if (!Converter<StdList>::isConvertible(sequence)) {
+            delete list;
+            PyErr_SetString(PyExc_TypeError, "invalid sequence for this list");
+            return 0;
+        }
+        StdList converted(Converter<StdList>::toCpp(sequence));
+        std::swap(*reinterpret_cast<StdList*>(list->data()), converted);
+        if (PyErr_Occurred()) {
+            delete list;
+            return 0;
+        }
+    }
+    return SharedList::newObject(list);
+}
+
+/// Returns the C++ container of \p pyObj if it's a shared list holding a StdList, or 0 otherwise.
+template <typename StdList>
+inline StdList* sharedListPointer(PyObject* pyObj)
+{
+    return reinterpret_cast<StdList*>(SharedList::cppPointer(pyObj, typeid(StdList)));
+}
+
+/**
+ *  Returns a reference to the C++ container shared by \p pyObj, which is modified in place,
+ *  or converts \p pyObj into \p local and returns it if it isn't a shared list holding a StdList.
+ */
+template <typename StdList>
+inline StdList& toCppReference(PyObject* pyObj, StdList& local)
+{
+    if (StdList* shared = sharedListPointer<StdList>(pyObj))
+        return *shared;
+    StdList converted(Converter<StdList>::toCpp(pyObj));
+    std::swap(local, converted);
+    return local;
+}
+
+} // namespace Shiboken
+
+#endif // SBKSHAREDLIST_H
@@ -0,0 +1,192 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "sbkstring.h"
+
+namespace Shiboken
+{
+
+namespace String
+{
+
+// The cache is a two way set associative table: each set keeps the two last strings with
+// contents hashed to it, and a miss replaces the one used least recently.
+static const unsigned CACHE_SETS = 1024;
+
+struct CacheEntry
+{
+    unsigned long hash;
+    PyObject* string;
+};
+
+struct CacheSet
+{
+    CacheEntry entries[2];
+    int lastUsed;
+};
+
+static CacheSet cache[CACHE_SETS];
+
+static inline unsigned long hashOf(const char* str, Py_ssize_t size)
+{
+    // FNV-1a
+    unsigned long hash = 2166136261UL;
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(str[i]);
+        hash *= 16777619UL;
+    }
+    return hash ^ static_cast<unsigned long>(size);
+}
+
+static inline bool matches(const CacheEntry& entry, unsigned long hash, const char* str, Py_ssize_t size)
+{
+    return entry.string && entry.hash == hash && PyString_GET_SIZE(entry.string) == size
+           && std::memcmp(PyString_AS_STRING(entry.string), str, size) == 0;
+}
+
+PyObject* fromCachedCString(const char* str, Py_ssize_t size)
+{
+    if (size > MAX_CACHED_LENGTH)
+        return PyString_FromStringAndSize(str, size);
+
+    unsigned long hash = hashOf(str, size);
+    CacheSet& set = cache[hash % CACHE_SETS];
+    for (int i = 0; i < 2; ++i) {
+        if (matches(set.entries[i], hash, str, size)) {
+            set.lastUsed = i;
+            Py_INCREF(set.entries[i].string);
+            return set.entries[i].string;
+        }
+    }
+
+    PyObject* string = PyString_FromStringAndSize(str, size);
+    if (!string)
+        return 0;
+    // Interned strings are compared by identity in dictionary lookups.
+    PyString_InternInPlace(&string);
+
+    int victim = 1 - set.lastUsed;
+    PyObject* old = set.entries[victim].string;
+    set.entries[victim].hash = hash;
+    set.entries[victim].string = string;
+    set.lastUsed = victim;
+    Py_INCREF(string);
+    Py_XDECREF(old);
+    return string;
+}
+
+void clearCache()
+{
+    for (unsigned i = 0; i < CACHE_SETS; ++i) {
+        for (int j = 0; j < 2; ++j) {
+            PyObject* old = cache[i].entries[j].string;
+            cache[i].entries[j].string = 0;
+            Py_XDECREF(old);
+        }
+    }
+}
+
+// Unicode characters are UTF-16 code units in narrow builds of Python.
+static inline bool isSurrogatePair(const Py_UNICODE* chars, Py_ssize_t i, Py_ssize_t size)
+{
+#if Py_UNICODE_SIZE == 2
+    return chars[i] >= 0xD800 && chars[i] <= 0xDBFF && i + 1 < size
+           && chars[i + 1] >= 0xDC00 && chars[i + 1] <= 0xDFFF;
+#else
+    return false;
+#endif
+}
+
+static char* encodeUtf8(const Py_UNICODE* chars, Py_ssize_t size, ConversionArena& arena)
+{
+    size_t length = 0;
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        unsigned long ch = chars[i];
+        if (ch < 0x80) {
+            length += 1;
+        } else if (ch < 0x800) {
+            length += 2;
+        } else if (isSurrogatePair(chars, i, size)) {
+            length += 4;
+            ++i;
+        } else {
+            length += ch < 0x10000 ? 3 : 4;
+        }
+    }
+
+    char* result = arena.createBuffer(length + 1);
+    unsigned char* out = reinterpret_cast<unsigned char*>(result);
+    for (Py_ssize_t i = 0; i < size; ++i) {
+        unsigned long ch = chars[i];
+        if (isSurrogatePair(chars, i, size)) {
+            ch = 0x10000 + ((ch - 0xD800) << 10) + (chars[i + 1] - 0xDC00);
+            ++i;
+        }
+        if (ch < 0x80) {
+            *out++ = ch;
+        } else if (ch < 0x800) {
+            *out++ = 0xC0 | (ch >> 6);
+            *out++ = 0x80 | (ch & 0x3F);
+        } else if (ch < 0x10000) {
+            *out++ = 0xE0 | (ch >> 12);
+            *out++ = 0x80 | ((ch >> 6) & 0x3F);
+            *out++ = 0x80 | (ch & 0x3F);
+        } else {
+            *out++ = 0xF0 | (ch >> 18);
+            *out++ = 0x80 | ((ch >> 12) & 0x3F);
+            *out++ = 0x80 | ((ch >> 6) & 0x3F);
+            *out++ = 0x80 | (ch & 0x3F);
+        }
+    }
+    *out = 0;
+    return result;
+}
+
+const char* toUtf8(PyObject* pyObj, ConversionArena& arena)
+{
+    if (PyString_Check(pyObj))
+        return PyString_AS_STRING(pyObj);
+    if (pyObj == Py_None)
+        return 0;
+    if (!PyUnicode_Check(pyObj)) {
+        PyErr_Format(PyExc_TypeError, "expected str or unicode, got '%s'", pyObj->ob_type->tp_name);
+        return 0;
+    }
+
+    // The default encoded string is kept by the unicode object once created. With the UTF-8
+    // default encoding it can be created here, with ASCII it is only used if it already exists.
+    const char* defaultEncoding = PyUnicode_GetDefaultEncoding();
+    PyObject* encoded = reinterpret_cast<PyUnicodeObject*>(pyObj)->defenc;
+    if (!std::strcmp(defaultEncoding, "utf-8") || !std::strcmp(defaultEncoding, "utf8"))
+        encoded = _PyUnicode_AsDefaultEncodedString(pyObj, 0);
+    else if (std::strcmp(defaultEncoding, "ascii"))
+        encoded = 0;
+    if (encoded)
+        return PyString_AS_STRING(encoded);
+    if (PyErr_Occurred())
+        return 0;
+    return encodeUtf8(PyUnicode_AS_UNICODE(pyObj), PyUnicode_GET_SIZE(pyObj), arena);
+}
+
+} // namespace String
+
+} // namespace Shiboken
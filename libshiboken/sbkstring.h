@@ -0,0 +1,85 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SBKSTRING_H
+#define SBKSTRING_H
+
+#include <Python.h>
+#include <cstring>
+#include <string>
+#include "shibokenmacros.h"
+#include "conversionarena.h"
+
+namespace Shiboken
+{
+
+namespace String
+{
+
+/// Strings longer than this are never kept in the cache of returned strings.
+const Py_ssize_t MAX_CACHED_LENGTH = 64;
+
+/**
+ *  Returns a new reference to a Python string with the \p size bytes of \p str. Short strings
+ *  are kept in a cache of limited size, so that returning the same contents again gives the
+ *  same interned Python string instead of allocating a new one. The GIL must be held.
+ */
+LIBSHIBOKEN_API PyObject* fromCachedCString(const char* str, Py_ssize_t size);
+
+/// Returns a new reference to the cached Python string for \p str, or None if \p str is null.
+inline PyObject* fromCachedCString(const char* str)
+{
+    if (!str)
+        Py_RETURN_NONE;
+    return fromCachedCString(str, std::strlen(str));
+}
+
+/// Returns a new reference to the cached Python string for the contents of \p str.
+inline PyObject* fromCachedCString(const std::string& str)
+{
+    return fromCachedCString(str.c_str(), str.size());
+}
+
+/// Releases the strings kept by the cache. Shiboken::init() registers it to run at interpreter exit.
+LIBSHIBOKEN_API void clearCache();
+
+/// Returns true if \p pyObj is a str or a unicode object.
+inline bool check(PyObject* pyObj)
+{
+    return PyString_Check(pyObj) || PyUnicode_Check(pyObj);
+}
+
+/**
+ *  Returns the contents of \p pyObj, a str or a unicode object, as a C string, or 0 for None.
+ *  Unicode objects are encoded in UTF-8 and the result is valid while both \p pyObj and \p arena
+ *  are alive: the default encoded string cached in the unicode object is used when the default
+ *  encoding gives the same bytes, otherwise the characters are encoded into \p arena, without
+ *  creating a Python string. Returns 0 with a Python exception set on errors.
+ */
+LIBSHIBOKEN_API const char* toUtf8(PyObject* pyObj, ConversionArena& arena);
+
+} // namespace String
+
+} // namespace Shiboken
+
+#endif // SBKSTRING_H
+
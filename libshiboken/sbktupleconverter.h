@@ -0,0 +1,137 @@
+/*
+ * This file is part of the Shiboken Python Bindings Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SBKTUPLECONVERTER_H
+#define SBKTUPLECONVERTER_H
+
+#ifdef _MSC_VER
+#include <tuple>
+#else
+#include <tr1/tuple>
+#endif
+#include "conversions.h"
+
+namespace Shiboken
+{
+
+/**
+ * Converts the elements of a std::tr1::tuple, from the one at \p Index to the last, to and
+ * from the items of a Python sequence. The recursion is expanded at compile time, so each
+ * element is converted by its own Converter without any loop or type dispatch.
+ */
+template <typename Tuple, int Index = 0, int Size = std::tr1::tuple_size<Tuple>::value>
+struct TupleElementsConverter
+{
+    typedef typename std::tr1::tuple_element<Index, Tuple>::type Element;
+    typedef TupleElementsConverter<Tuple, Index + 1, Size> Next;
+
+    static inline bool isConvertible(PyObject** items)
+    {
+        return Converter<Element>::isConvertible(items[Index]) && Next::isConvertible(items);
+    }
+
+    static inline void toPython(const Tuple& cppObj, PyObject* tuple)
+    {
+        Element element(std::tr1::get<Index>(cppObj));
+        PyTuple_SET_ITEM(tuple, Index, Converter<Element>::toPython(element));
+        Next::toPython(cppObj, tuple);
+    }
+
+    static inline void toCpp(PyObject** items, Tuple& cppObj)
+    {
+        std::tr1::get<Index>(cppObj) = Converter<Element>::toCpp(items[Index]);
+        Next::toCpp(items, cppObj);
+    }
+};
+
+template <typename Tuple, int Size>
+struct TupleElementsConverter<Tuple, Size, Size>
+{
+    static inline bool isConvertible(PyObject**) { return true; }
+    static inline void toPython(const Tuple&, PyObject*) {}
+    static inline void toCpp(PyObject**, Tuple&) {}
+};
+
+/**
+ * Converter for std::tr1::tuple types, used like the other container converters:
+ *
+ * template<> struct Converter<std::tr1::tuple<int, double, std::string> >
+ *     : StdTupleConverter<std::tr1::tuple<int, double, std::string> > {};
+ *
+ * Exact Python tuples are read in place, other sequences through PySequence_Fast.
+ */
+template <typename StdTuple>
+struct StdTupleConverter
+{
+    typedef TupleElementsConverter<StdTuple> Elements;
+    enum { Size = std::tr1::tuple_size<StdTuple>::value };
+
+    static inline bool checkType(PyObject* pyObj)
+    {
+        return isConvertible(pyObj);
+    }
+
+    static inline bool isConvertible(PyObject* pyObj)
+    {
+        if (PyObject_TypeCheck(pyObj, SbkType<StdTuple>()))
+            return true;
+        if (PyTuple_CheckExact(pyObj))
+            return PyTuple_GET_SIZE(pyObj) == Size && Elements::isConvertible(&PyTuple_GET_ITEM(pyObj, 0));
+        if ((SbkType<StdTuple>() && Object::checkType(pyObj)) || !PySequence_Check(pyObj))
+            return false;
+        AutoDecRef fastSequence(PySequence_Fast(pyObj, "Sequence expected."));
+        if (fastSequence.isNull()) {
+            PyErr_Clear();
+            return false;
+        }
+        return PySequence_Fast_GET_SIZE(fastSequence.object()) == Size
+               && Elements::isConvertible(PySequence_Fast_ITEMS(fastSequence.object()));
+    }
+
+    static PyObject* toPython(void* cppObj) { return toPython(*reinterpret_cast<StdTuple*>(cppObj)); }
+    static PyObject* toPython(const StdTuple& cppobj)
+    {
+        PyObject* tuple = PyTuple_New(Size);
+        Elements::toPython(cppobj, tuple);
+        return tuple;
+    }
+
+    static StdTuple toCpp(PyObject* pyobj)
+    {
+        if (PyObject_TypeCheck(pyobj, SbkType<StdTuple>()))
+            return *reinterpret_cast<StdTuple*>(Object::cppPointer(reinterpret_cast<SbkObject*>(pyobj), SbkType<StdTuple>()));
+
+        StdTuple result;
+        if (PyTuple_CheckExact(pyobj)) {
+            Elements::toCpp(&PyTuple_GET_ITEM(pyobj, 0), result);
+            return result;
+        }
+        AutoDecRef fastSequence(PySequence_Fast(pyobj, "Sequence expected."));
+        if (!fastSequence.isNull())
+            Elements::toCpp(PySequence_Fast_ITEMS(fastSequence.object()), result);
+        return result;
+    }
+};
+
+} // namespace Shiboken
+
+#endif // SBKTUPLECONVERTER_H
@@ -28,11 +28,19 @@
 #include "basewrapper.h"
 #include "bindingmanager.h"
 #include "conversions.h"
+#include "conversionarena.h"
 #include "gilstate.h"
 #include "threadstatesaver.h"
 #include "helper.h"
 #include "sbkenum.h"
 #include "sbkmodule.h"
+#include "sbkmapproxy.h"
+#include "sbksequenceview.h"
+#include "sbksharedlist.h"
+#include "sbkarray.h"
+#include "sbkstring.h"
+#include "sbkcopy.h"
+#include "sbkpickle.h"
 #include "shibokenmacros.h"
 #include "typeresolver.h"
 #include "shibokenbuffer.h"
@@ -21,11 +21,18 @@
 */
 
 #include "shibokenbuffer.h"
+#include "autodecref.h"
 #include <cstdlib>
 #include <cstring>
+#include <map>
+#include <vector>
 
 bool Shiboken::Buffer::checkType(PyObject* pyObj)
 {
+#if PY_VERSION_HEX >= 0x02060000
+    if (PyObject_CheckBuffer(pyObj))
+        return true;
+#endif
     return PyObject_CheckReadBuffer(pyObj);
 }
 
@@ -34,6 +41,22 @@ void* Shiboken::Buffer::getPointer(PyObject* pyObj, Py_ssize_t* size)
     const void* buffer = 0;
     Py_ssize_t bufferSize = 0;
 
+#if PY_VERSION_HEX >= 0x02060000
+    // Objects like memoryview only implement the new buffer protocol.
+    if (PyObject_CheckBuffer(pyObj) && !PyObject_CheckReadBuffer(pyObj)) {
+        Py_buffer view;
+        if (PyObject_GetBuffer(pyObj, &view, PyBUF_SIMPLE) == 0) {
+            // As with the old protocol, the memory is kept valid by the exporter.
+            buffer = view.buf;
+            bufferSize = view.len;
+            PyBuffer_Release(&view);
+        }
+        if (size)
+            *size = bufferSize;
+        return const_cast<void*>(buffer);
+    }
+#endif
+
     PyObject_AsReadBuffer(pyObj, &buffer, &bufferSize);
 
     if (size)
@@ -41,6 +64,43 @@ void* Shiboken::Buffer::getPointer(PyObject* pyObj, Py_ssize_t* size)
     return const_cast<void*>(buffer);
 }
 
+bool Shiboken::Buffer::ByteView::check(PyObject* pyObj)
+{
+    return pyObj == Py_None || PyString_Check(pyObj) || (!PyUnicode_Check(pyObj) && checkType(pyObj));
+}
+
+Shiboken::Buffer::ByteView::ByteView(PyObject* pyObj)
+    : m_data(0), m_size(0), m_hasView(false), m_valid(true)
+{
+    if (!pyObj || pyObj == Py_None)
+        return;
+    if (PyString_Check(pyObj)) {
+        m_data = PyString_AS_STRING(pyObj);
+        m_size = PyString_GET_SIZE(pyObj);
+        return;
+    }
+#if PY_VERSION_HEX >= 0x02060000
+    if (PyObject_CheckBuffer(pyObj)) {
+        m_hasView = PyObject_GetBuffer(pyObj, &m_view, PyBUF_SIMPLE) == 0;
+        m_valid = m_hasView;
+        if (m_hasView) {
+            m_data = m_view.buf;
+            m_size = m_view.len;
+        }
+        return;
+    }
+#endif
+    m_valid = PyObject_AsReadBuffer(pyObj, &m_data, &m_size) == 0;
+}
+
+Shiboken::Buffer::ByteView::~ByteView()
+{
+#if PY_VERSION_HEX >= 0x02060000
+    if (m_hasView)
+        PyBuffer_Release(&m_view);
+#endif
+}
+
 PyObject* Shiboken::Buffer::newObject(void* memory, Py_ssize_t size, Type type)
 {
     return type == ReadOnly ? PyBuffer_FromMemory(memory, size) : PyBuffer_FromReadWriteMemory(memory, size);
@@ -50,3 +110,590 @@ PyObject* Shiboken::Buffer::newObject(const void* memory, Py_ssize_t size)
 {
     return newObject(const_cast<void*>(memory), size, ReadOnly);
 }
+
+namespace Shiboken
+{
+namespace Buffer
+{
+
+Layout::Layout() : memory(0), readOnly(false), itemSize(1), format("B"), ndim(1)
+{
+    shape[0] = 0;
+    strides[0] = 1;
+}
+
+void Layout::setShape(int ndim, const Py_ssize_t* shape)
+{
+    this->ndim = ndim;
+    Py_ssize_t stride = itemSize;
+    for (int i = ndim - 1; i >= 0; --i) {
+        this->shape[i] = shape[i];
+        strides[i] = stride;
+        stride *= shape[i];
+    }
+}
+
+bool Layout::isCContiguous() const
+{
+    Py_ssize_t stride = itemSize;
+    for (int i = ndim - 1; i >= 0; --i) {
+        if (shape[i] > 1 && strides[i] != stride)
+            return false;
+        stride *= shape[i];
+    }
+    return true;
+}
+
+bool Layout::isFortranContiguous() const
+{
+    Py_ssize_t stride = itemSize;
+    for (int i = 0; i < ndim; ++i) {
+        if (shape[i] > 1 && strides[i] != stride)
+            return false;
+        stride *= shape[i];
+    }
+    return true;
+}
+
+Py_ssize_t Layout::size() const
+{
+    Py_ssize_t result = itemSize;
+    for (int i = 0; i < ndim; ++i)
+        result *= shape[i];
+    return result;
+}
+
+#if PY_VERSION_HEX >= 0x02060000
+
+/**
+ * Shape and strides given to the views of an exporter. They are freed only when all its views
+ * are released, since Python 2 memoryviews hand copies of their own view to other consumers.
+ */
+struct ExportedDimensions
+{
+    ExportedDimensions() : views(0) {}
+    int views;
+    std::vector<Py_ssize_t*> blocks;
+};
+typedef std::map<PyObject*, ExportedDimensions> ExportedDimensionsMap;
+static ExportedDimensionsMap exportedDimensions;
+
+int fillInfo(Py_buffer* view, PyObject* exporter, const Layout& layout, int flags)
+{
+    if (!view)
+        return 0;
+    if (layout.ndim < 0 || layout.ndim > Layout::MaxDimensions) {
+        PyErr_SetString(PyExc_BufferError, "Invalid number of buffer dimensions.");
+        return -1;
+    }
+    if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE && layout.readOnly) {
+        PyErr_SetString(PyExc_BufferError, "Object is not writable.");
+        return -1;
+    }
+
+    bool cContiguous = layout.isCContiguous();
+    // Consumers that don't take strides assume a C contiguous block.
+    if ((flags & PyBUF_STRIDES) != PyBUF_STRIDES || (flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS) {
+        if (!cContiguous) {
+            PyErr_SetString(PyExc_BufferError, "Object is not C contiguous.");
+            return -1;
+        }
+    }
+    if ((flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS && !layout.isFortranContiguous()) {
+        PyErr_SetString(PyExc_BufferError, "Object is not Fortran contiguous.");
+        return -1;
+    }
+    if ((flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS && !cContiguous && !layout.isFortranContiguous()) {
+        PyErr_SetString(PyExc_BufferError, "Object is not contiguous.");
+        return -1;
+    }
+
+    view->buf = layout.memory;
+    view->len = layout.size();
+    view->itemsize = layout.itemSize;
+    view->readonly = layout.readOnly;
+    view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? const_cast<char*>(layout.format) : 0;
+    view->suboffsets = 0;
+    view->shape = 0;
+    view->strides = 0;
+    view->internal = 0;
+    if ((flags & PyBUF_ND) == PyBUF_ND) {
+        view->ndim = layout.ndim;
+        // Shape and strides are copied, they must live as long as the view.
+        Py_ssize_t* dimensions = static_cast<Py_ssize_t*>(std::malloc(2 * (layout.ndim + 1) * sizeof(Py_ssize_t)));
+        if (!dimensions) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        std::memcpy(dimensions, layout.shape, layout.ndim * sizeof(Py_ssize_t));
+        view->shape = dimensions;
+        if ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) {
+            std::memcpy(dimensions + layout.ndim, layout.strides, layout.ndim * sizeof(Py_ssize_t));
+            view->strides = dimensions + layout.ndim;
+        }
+        exportedDimensions[exporter].blocks.push_back(dimensions);
+    } else {
+        view->ndim = 1;
+    }
+    exportedDimensions[exporter].views++;
+
+    Py_XINCREF(exporter);
+    view->obj = exporter;
+    return 0;
+}
+
+void releaseInfo(PyObject* exporter, Py_buffer*)
+{
+    ExportedDimensionsMap::iterator it = exportedDimensions.find(exporter);
+    if (it == exportedDimensions.end() || --it->second.views > 0)
+        return;
+    for (std::vector<Py_ssize_t*>::iterator block = it->second.blocks.begin(); block != it->second.blocks.end(); ++block)
+        std::free(*block);
+    exportedDimensions.erase(it);
+}
+
+static Py_ssize_t legacyBuffer(PyObject* self, Py_ssize_t segment, void** ptrptr, int flags)
+{
+    if (segment) {
+        PyErr_SetString(PyExc_SystemError, "Accessing non-existent buffer segment.");
+        return -1;
+    }
+    Py_buffer view;
+    if (PyObject_GetBuffer(self, &view, flags) < 0)
+        return -1;
+    *ptrptr = view.buf;
+    Py_ssize_t size = view.len;
+    PyBuffer_Release(&view);
+    return size;
+}
+
+Py_ssize_t readBufferProc(PyObject* self, Py_ssize_t segment, void** ptrptr)
+{
+    return legacyBuffer(self, segment, ptrptr, PyBUF_SIMPLE);
+}
+
+Py_ssize_t writeBufferProc(PyObject* self, Py_ssize_t segment, void** ptrptr)
+{
+    return legacyBuffer(self, segment, ptrptr, PyBUF_WRITABLE);
+}
+
+Py_ssize_t segmentCountProc(PyObject* self, Py_ssize_t* lenp)
+{
+    if (lenp) {
+        void* ptr;
+        *lenp = legacyBuffer(self, 0, &ptr, PyBUF_SIMPLE);
+        if (*lenp < 0) {
+            PyErr_Clear();
+            *lenp = 0;
+        }
+    }
+    return 1;
+}
+
+Py_ssize_t charBufferProc(PyObject* self, Py_ssize_t segment, char** ptrptr)
+{
+    return legacyBuffer(self, segment, reinterpret_cast<void**>(ptrptr), PyBUF_SIMPLE);
+}
+
+View::View(PyObject* pyObj, int flags)
+{
+    m_valid = PyObject_GetBuffer(pyObj, &m_view, flags) == 0;
+    if (!m_valid)
+        std::memset(&m_view, 0, sizeof(Py_buffer));
+}
+
+View::~View()
+{
+    if (m_valid)
+        PyBuffer_Release(&m_view);
+}
+
+#else
+
+int fillInfo(Py_buffer*, PyObject*, const Layout&, int)
+{
+    PyErr_SetString(PyExc_TypeError, "The new buffer protocol requires Python 2.6.");
+    return -1;
+}
+
+void releaseInfo(PyObject*, Py_buffer*)
+{
+}
+
+View::View(PyObject*, int) : m_valid(false)
+{
+    std::memset(&m_view, 0, sizeof(Py_buffer));
+    PyErr_SetString(PyExc_TypeError, "The new buffer protocol requires Python 2.6.");
+}
+
+View::~View()
+{
+}
+
+#endif
+
+/// PyArrayInterface structure of NumPy, exported in "__array_struct__".
+struct ArrayInterface
+{
+    int two;
+    int nd;
+    char typekind;
+    int itemsize;
+    int flags;
+    Py_intptr_t* shape;
+    Py_intptr_t* strides;
+    void* data;
+    PyObject* descr;
+};
+
+enum ArrayInterfaceFlags {
+    ArrayCContiguous = 0x1,
+    ArrayFortranContiguous = 0x2,
+    ArrayAligned = 0x100,
+    ArrayNotSwapped = 0x200,
+    ArrayWriteable = 0x400
+};
+
+static bool isLittleEndian()
+{
+    const int one = 1;
+    return *reinterpret_cast<const char*>(&one) == 1;
+}
+
+/**
+ * Fills \p layout from \p view and finds the array interface type kind and byte order of its
+ * items, returns false with a Python error set if they can't be described by the array interface.
+ */
+static bool arrayLayout(const Py_buffer& view, Layout* layout, char* kind, char* byteOrder)
+{
+    const char* format = view.format ? view.format : "B";
+    char order = '=';
+    if (std::strchr("@=<>!", *format))
+        order = *format++;
+
+    *kind = 0;
+    if (*format && !format[1]) {
+        switch (*format) {
+            case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+                *kind = 'i';
+                break;
+            case 'B': case 'H': case 'I': case 'L': case 'Q': case 'N':
+                *kind = 'u';
+                break;
+            case 'f': case 'd':
+                *kind = 'f';
+                break;
+            case '?':
+                *kind = 'b';
+                break;
+            case 'c':
+                *kind = 'S';
+                break;
+        }
+    }
+    if (!*kind || view.ndim > Layout::MaxDimensions) {
+        PyErr_Format(PyExc_ValueError, "Buffer with format '%s' and %d dimensions can't be described by the array interface.",
+                     view.format ? view.format : "B", view.ndim);
+        return false;
+    }
+
+    if (view.itemsize == 1)
+        *byteOrder = '|';
+    else if (order == '<' || order == '>')
+        *byteOrder = order;
+    else if (order == '!')
+        *byteOrder = '>';
+    else
+        *byteOrder = isLittleEndian() ? '<' : '>';
+
+    layout->memory = view.buf;
+    layout->readOnly = view.readonly;
+    layout->itemSize = view.itemsize;
+    if (view.shape) {
+        layout->setShape(view.ndim, view.shape);
+        if (view.strides)
+            std::memcpy(layout->strides, view.strides, view.ndim * sizeof(Py_ssize_t));
+    } else {
+        Py_ssize_t size = view.itemsize ? view.len / view.itemsize : 0;
+        layout->setShape(1, &size);
+    }
+    return true;
+}
+
+PyObject* arrayInterface(const Py_buffer& view)
+{
+    Layout layout;
+    char kind;
+    char byteOrder;
+    if (!arrayLayout(view, &layout, &kind, &byteOrder))
+        return 0;
+
+    PyObject* shape = PyTuple_New(layout.ndim);
+    PyObject* strides = PyTuple_New(layout.ndim);
+    for (int i = 0; i < layout.ndim; ++i) {
+        PyTuple_SET_ITEM(shape, i, PyInt_FromSsize_t(layout.shape[i]));
+        PyTuple_SET_ITEM(strides, i, PyInt_FromSsize_t(layout.strides[i]));
+    }
+    PyObject* result = PyDict_New();
+    PyObject* typestr = PyString_FromFormat("%c%c%d", byteOrder, kind, int(layout.itemSize));
+    PyObject* data = Py_BuildValue("(NO)", PyLong_FromVoidPtr(layout.memory), layout.readOnly ? Py_True : Py_False);
+    PyObject* version = PyInt_FromLong(3);
+    PyDict_SetItemString(result, "shape", shape);
+    PyDict_SetItemString(result, "strides", strides);
+    PyDict_SetItemString(result, "typestr", typestr);
+    PyDict_SetItemString(result, "data", data);
+    PyDict_SetItemString(result, "version", version);
+    Py_DECREF(shape);
+    Py_DECREF(strides);
+    Py_DECREF(typestr);
+    Py_DECREF(data);
+    Py_DECREF(version);
+    return result;
+}
+
+#if PY_MAJOR_VERSION >= 3
+static void arrayStructDestructor(PyObject* capsule)
+{
+    std::free(PyCapsule_GetPointer(capsule, 0));
+    Py_XDECREF(reinterpret_cast<PyObject*>(PyCapsule_GetContext(capsule)));
+}
+#else
+static void arrayStructDestructor(void* arrayInterface, void* owner)
+{
+    std::free(arrayInterface);
+    Py_XDECREF(reinterpret_cast<PyObject*>(owner));
+}
+#endif
+
+PyObject* arrayStruct(const Py_buffer& view)
+{
+    Layout layout;
+    char kind;
+    char byteOrder;
+    if (!arrayLayout(view, &layout, &kind, &byteOrder))
+        return 0;
+
+    // The shape and strides are stored right after the structure.
+    ArrayInterface* result = static_cast<ArrayInterface*>(std::malloc(sizeof(ArrayInterface) + 2 * layout.ndim * sizeof(Py_intptr_t)));
+    if (!result)
+        return PyErr_NoMemory();
+    result->two = 2;
+    result->nd = layout.ndim;
+    result->typekind = kind;
+    result->itemsize = int(layout.itemSize);
+    result->flags = ArrayAligned;
+    if (layout.isCContiguous())
+        result->flags |= ArrayCContiguous;
+    if (layout.isFortranContiguous())
+        result->flags |= ArrayFortranContiguous;
+    if (byteOrder == '|' || byteOrder == (isLittleEndian() ? '<' : '>'))
+        result->flags |= ArrayNotSwapped;
+    if (!layout.readOnly)
+        result->flags |= ArrayWriteable;
+    result->shape = reinterpret_cast<Py_intptr_t*>(result + 1);
+    result->strides = result->shape + layout.ndim;
+    for (int i = 0; i < layout.ndim; ++i) {
+        result->shape[i] = layout.shape[i];
+        result->strides[i] = layout.strides[i];
+    }
+    result->data = layout.memory;
+    result->descr = 0;
+
+    // The memory belongs to the exporter, it must live as long as the structure.
+    Py_XINCREF(view.obj);
+#if PY_MAJOR_VERSION >= 3
+    PyObject* capsule = PyCapsule_New(result, 0, &arrayStructDestructor);
+    if (capsule)
+        PyCapsule_SetContext(capsule, view.obj);
+#else
+    PyObject* capsule = PyCObject_FromVoidPtrAndDesc(result, view.obj, &arrayStructDestructor);
+#endif
+    if (!capsule) {
+        std::free(result);
+        Py_XDECREF(view.obj);
+    }
+    return capsule;
+}
+
+static PyObject* arrayInterfaceGetter(PyObject* self, void*)
+{
+    View view(self, PyBUF_STRIDES | PyBUF_FORMAT);
+    if (view.isNull())
+        return 0;
+    return arrayInterface(view.buffer());
+}
+
+static PyObject* arrayStructGetter(PyObject* self, void*)
+{
+    View view(self, PyBUF_STRIDES | PyBUF_FORMAT);
+    if (view.isNull())
+        return 0;
+    return arrayStruct(view.buffer());
+}
+
+PyGetSetDef arrayInterfaceGetSet[] = {
+    {const_cast<char*>("__array_interface__"), &arrayInterfaceGetter, 0, 0, 0},
+    {const_cast<char*>("__array_struct__"), &arrayStructGetter, 0, 0, 0},
+    {0} // Sentinel
+};
+
+bool addArrayInterface(PyTypeObject* type)
+{
+    for (PyGetSetDef* getset = arrayInterfaceGetSet; getset->name; ++getset) {
+        PyObject* descr = PyDescr_NewGetSet(type, getset);
+        if (!descr || PyDict_SetItemString(type->tp_dict, getset->name, descr) < 0) {
+            Py_XDECREF(descr);
+            return false;
+        }
+        Py_DECREF(descr);
+    }
+    PyType_Modified(type);
+    return true;
+}
+
+Py_ssize_t View::shape(int dimension) const
+{
+    if (!m_view.shape)
+        return dimension == 0 && m_view.itemsize ? m_view.len / m_view.itemsize : 1;
+    return m_view.shape[dimension];
+}
+
+Py_ssize_t View::stride(int dimension) const
+{
+    if (m_view.strides)
+        return m_view.strides[dimension];
+    // C contiguous block.
+    Py_ssize_t result = m_view.itemsize;
+    for (int i = m_view.ndim - 1; i > dimension; --i)
+        result *= shape(i);
+    return result;
+}
+
+static Py_ssize_t nativeItemSize(char format)
+{
+    switch (format) {
+        case 'b':
+        case 'B':
+            return 1;
+        case 'h':
+        case 'H':
+            return sizeof(short);
+        case 'i':
+        case 'I':
+            return sizeof(int);
+        case 'l':
+        case 'L':
+            return sizeof(long);
+        case 'q':
+        case 'Q':
+            return sizeof(PY_LONG_LONG);
+        case 'f':
+            return sizeof(float);
+        case 'd':
+            return sizeof(double);
+        case '?':
+            return sizeof(bool);
+        default:
+            return 0;
+    }
+}
+
+NumberReader::NumberReader()
+    : m_data(0), m_count(0), m_stride(0), m_format(0), m_object(0), m_hasView(false)
+{
+}
+
+NumberReader::~NumberReader()
+{
+#if PY_VERSION_HEX >= 0x02060000
+    if (m_hasView)
+        PyBuffer_Release(&m_view);
+#endif
+    Py_XDECREF(m_object);
+}
+
+bool NumberReader::setFormat(const char* format, Py_ssize_t itemSize)
+{
+    // Only single native numbers are read.
+    if (*format == '@')
+        ++format;
+    if (!format[0] || format[1] || nativeItemSize(format[0]) != itemSize) {
+        PyErr_Format(PyExc_ValueError, "unsupported buffer item format '%s'", format);
+        return false;
+    }
+    m_format = format[0];
+    return true;
+}
+
+bool NumberReader::open(PyObject* pyObj)
+{
+#if PY_VERSION_HEX >= 0x02060000
+    if (PyObject_CheckBuffer(pyObj)) {
+        if (PyObject_GetBuffer(pyObj, &m_view, PyBUF_STRIDED_RO | PyBUF_FORMAT) < 0)
+            return false;
+        m_hasView = true;
+        if (m_view.ndim != 1) {
+            PyErr_SetString(PyExc_ValueError, "expected a one dimensional buffer");
+            return false;
+        }
+        if (!setFormat(m_view.format ? m_view.format : "B", m_view.itemsize))
+            return false;
+        m_data = reinterpret_cast<const char*>(m_view.buf);
+        m_count = m_view.shape ? m_view.shape[0] : m_view.len / m_view.itemsize;
+        m_stride = m_view.strides ? m_view.strides[0] : m_view.itemsize;
+        return true;
+    }
+#endif
+
+    // array.array only exports its memory through the old buffer protocol in Python 2.
+    if (PyObject_CheckReadBuffer(pyObj) && PyObject_HasAttrString(pyObj, "typecode")
+        && PyObject_HasAttrString(pyObj, "itemsize")) {
+        AutoDecRef typeCode(PyObject_GetAttrString(pyObj, "typecode"));
+        AutoDecRef itemSize(PyObject_GetAttrString(pyObj, "itemsize"));
+        if (typeCode.isNull() || itemSize.isNull())
+            return false;
+        if (!PyString_Check(typeCode.object()) || !PyInt_Check(itemSize.object())) {
+            PyErr_SetString(PyExc_TypeError, "invalid typecode or itemsize of the array");
+            return false;
+        }
+        if (!setFormat(PyString_AS_STRING(typeCode.object()), PyInt_AS_LONG(itemSize.object())))
+            return false;
+        const void* data = 0;
+        Py_ssize_t size = 0;
+        if (PyObject_AsReadBuffer(pyObj, &data, &size) < 0)
+            return false;
+        m_data = reinterpret_cast<const char*>(data);
+        m_stride = PyInt_AS_LONG(itemSize.object());
+        m_count = size / m_stride;
+        Py_INCREF(pyObj);
+        m_object = pyObj;
+        return true;
+    }
+
+    PyErr_Format(PyExc_TypeError, "expected a buffer of numbers, got '%s'", pyObj->ob_type->tp_name);
+    return false;
+}
+
+Py_ssize_t NumberReader::openAll(NumberReader* readers, int count, PyObject* args, const char* funcName)
+{
+    if (PyTuple_GET_SIZE(args) != count) {
+        PyErr_Format(PyExc_TypeError, "%s() takes exactly %d arguments (%d given)",
+                     funcName, count, static_cast<int>(PyTuple_GET_SIZE(args)));
+        return -1;
+    }
+    Py_ssize_t result = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!readers[i].open(PyTuple_GET_ITEM(args, i)))
+            return -1;
+        if (i == 0) {
+            result = readers[i].count();
+        } else if (readers[i].count() != result) {
+            PyErr_Format(PyExc_ValueError, "%s() arguments must have the same number of items", funcName);
+            return -1;
+        }
+    }
+    return result;
+}
+
+} // namespace Buffer
+} // namespace Shiboken
@@ -24,7 +24,11 @@
 #define SHIBOKEN_BUFFER_H
 
 #include <Python.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include "shibokenmacros.h"
+#include "python25compat.h"
 
 namespace Shiboken
 {
@@ -62,6 +66,293 @@ namespace Buffer
      */
     LIBSHIBOKEN_API void* getPointer(PyObject* pyObj, Py_ssize_t* size = 0);
 
+    /**
+     * Describes a block of typed memory, with up to MaxDimensions dimensions, exported through
+     * the Python buffer protocol (PEP 3118). Strides are given in bytes and may be negative.
+     */
+    struct LIBSHIBOKEN_API Layout
+    {
+        enum { MaxDimensions = 8 };
+
+        /// Creates the layout of an empty, writable block of bytes.
+        Layout();
+
+        /**
+         * Sets \p ndim dimensions with the sizes given in \p shape, for items stored contiguously
+         * in row major (C) order.
+         */
+        void setShape(int ndim, const Py_ssize_t* shape);
+
+        /// Returns true if the items are stored contiguously in row major (C) order.
+        bool isCContiguous() const;
+        /// Returns true if the items are stored contiguously in column major (Fortran) order.
+        bool isFortranContiguous() const;
+        /// Number of bytes used by the items.
+        Py_ssize_t size() const;
+
+        void* memory;
+        bool readOnly;
+        Py_ssize_t itemSize;
+        /// Item format in the struct module syntax, "B" for unsigned bytes.
+        const char* format;
+        int ndim;
+        Py_ssize_t shape[MaxDimensions];
+        Py_ssize_t strides[MaxDimensions];
+    };
+
+    /**
+     * Fills \p view with the memory described by \p layout, as requested by the buffer consumer
+     * \p flags, to be used in bf_getbuffer implementations. \p exporter is the object owning the
+     * memory. Returns 0 on success, or -1 with a Python error set if the layout can't be
+     * exported as requested. Views filled by this function must be released with releaseInfo.
+     */
+    LIBSHIBOKEN_API int fillInfo(Py_buffer* view, PyObject* exporter, const Layout& layout, int flags);
+
+    /// Releases the resources of a view of \p exporter filled by fillInfo, to be used as bf_releasebuffer.
+    LIBSHIBOKEN_API void releaseInfo(PyObject* exporter, Py_buffer* view);
+
+    /**
+     * Legacy buffer procedures implemented over the bf_getbuffer of the object type, to be used
+     * by types exporting contiguous memory through the new buffer protocol that must also work
+     * with Python 2 APIs like PyObject_AsReadBuffer.
+     */
+    LIBSHIBOKEN_API Py_ssize_t readBufferProc(PyObject* self, Py_ssize_t segment, void** ptrptr);
+    LIBSHIBOKEN_API Py_ssize_t writeBufferProc(PyObject* self, Py_ssize_t segment, void** ptrptr);
+    LIBSHIBOKEN_API Py_ssize_t segmentCountProc(PyObject* self, Py_ssize_t* lenp);
+    LIBSHIBOKEN_API Py_ssize_t charBufferProc(PyObject* self, Py_ssize_t segment, char** ptrptr);
+
+    /**
+     * Returns a new dictionary describing the memory of \p view as the "__array_interface__" of
+     * the array consumers (version 3 of the NumPy array interface), or 0 with a Python error set
+     * if the item format isn't a single numeric type.
+     */
+    LIBSHIBOKEN_API PyObject* arrayInterface(const Py_buffer& view);
+
+    /**
+     * Returns a new object wrapping a PyArrayInterface structure describing the memory of
+     * \p view, as the "__array_struct__" of the array consumers. The object keeps the exporter
+     * of \p view alive. Returns 0 with a Python error set if the item format isn't a single
+     * numeric type.
+     */
+    LIBSHIBOKEN_API PyObject* arrayStruct(const Py_buffer& view);
+
+    /**
+     * Adds the "__array_interface__" and "__array_struct__" attributes to \p type, which must
+     * export its memory through the new buffer protocol. NumPy isn't needed for this.
+     */
+    LIBSHIBOKEN_API bool addArrayInterface(PyTypeObject* type);
+
+    /// Getset definitions of the array interface attributes, ended by a sentinel.
+    LIBSHIBOKEN_API extern PyGetSetDef arrayInterfaceGetSet[];
+
+    /// Buffer protocol item format of the type T, in the struct module syntax.
+    template<typename T> struct FormatOf {};
+    // Plain char items are converted to one character strings.
+    template<> struct FormatOf<char> { static const char* value() { return "c"; } };
+    template<> struct FormatOf<signed char> { static const char* value() { return "b"; } };
+    template<> struct FormatOf<unsigned char> { static const char* value() { return "B"; } };
+    template<> struct FormatOf<short> { static const char* value() { return "h"; } };
+    template<> struct FormatOf<unsigned short> { static const char* value() { return "H"; } };
+    template<> struct FormatOf<int> { static const char* value() { return "i"; } };
+    template<> struct FormatOf<unsigned int> { static const char* value() { return "I"; } };
+    template<> struct FormatOf<long> { static const char* value() { return "l"; } };
+    template<> struct FormatOf<unsigned long> { static const char* value() { return "L"; } };
+    template<> struct FormatOf<PY_LONG_LONG> { static const char* value() { return "q"; } };
+    template<> struct FormatOf<unsigned PY_LONG_LONG> { static const char* value() { return "Q"; } };
+    template<> struct FormatOf<float> { static const char* value() { return "f"; } };
+    template<> struct FormatOf<double> { static const char* value() { return "d"; } };
+    template<> struct FormatOf<bool> { static const char* value() { return "?"; } };
+
+    /**
+     * Gives access to the memory exported by an object through the new buffer protocol, which is
+     * released when the view is destroyed.
+     */
+    class LIBSHIBOKEN_API View
+    {
+    public:
+        /**
+         * Requests the buffer of \p pyObj with the given \p flags (see PyObject_GetBuffer). If it
+         * fails the view is null and a Python error is set.
+         */
+        explicit View(PyObject* pyObj, int flags = PyBUF_FULL_RO);
+        ~View();
+
+        bool isNull() const { return !m_valid; }
+        void* data() const { return m_view.buf; }
+        /// Number of bytes used by the items.
+        Py_ssize_t size() const { return m_view.len; }
+        Py_ssize_t itemSize() const { return m_view.itemsize; }
+        /// Item format in the struct module syntax, "B" if the exporter didn't give one.
+        const char* format() const { return m_view.format ? m_view.format : "B"; }
+        bool isReadOnly() const { return m_view.readonly; }
+        int dimensions() const { return m_view.ndim; }
+        Py_ssize_t shape(int dimension) const;
+        /// Distance in bytes between two items along \p dimension.
+        Py_ssize_t stride(int dimension) const;
+        const Py_buffer& buffer() const { return m_view; }
+
+    private:
+        View(const View&);
+        View& operator=(const View&);
+
+        Py_buffer m_view;
+        bool m_valid;
+    };
+
+    /**
+     * Read only access to the bytes of a Python string, or of any object exporting contiguous
+     * memory through the buffer protocols, without copying them. The memory is held until the
+     * view is destroyed, so a view living in a wrapper function lends it for the whole call.
+     * None and null objects give an empty view with a null pointer.
+     */
+    class LIBSHIBOKEN_API ByteView
+    {
+    public:
+        /// Returns true if the bytes of \p pyObj can be viewed. Unicode objects are rejected.
+        static bool check(PyObject* pyObj);
+
+        /// Views the bytes of \p pyObj. If it fails the view is null and a Python error is set.
+        explicit ByteView(PyObject* pyObj);
+        ~ByteView();
+
+        bool isNull() const { return !m_valid; }
+        const void* data() const { return m_data; }
+        Py_ssize_t size() const { return m_size; }
+
+    private:
+        ByteView(const ByteView&);
+        ByteView& operator=(const ByteView&);
+
+        const void* m_data;
+        Py_ssize_t m_size;
+        Py_buffer m_view;
+        bool m_hasView;
+        bool m_valid;
+    };
+
+    /**
+     * Checks if a number of type Source overflows when cast to T, as it would when passed to
+     * an integer argument. Floating point numbers are truncated first. Floating point and bool
+     * targets hold any number.
+     */
+    template <typename T, typename Source,
+              bool isIntegerTarget = std::numeric_limits<T>::is_integer && (std::numeric_limits<T>::digits > 1),
+              bool isIntegerSource = std::numeric_limits<Source>::is_integer>
+    struct NumberRange
+    {
+        static inline bool overflows(Source) { return false; }
+    };
+
+    template <typename T, typename Source>
+    struct NumberRange<T, Source, true, true>
+    {
+        static inline bool overflows(Source value)
+        {
+            if (std::numeric_limits<Source>::is_signed && value < 0) {
+                return !std::numeric_limits<T>::is_signed
+                       || static_cast<PY_LONG_LONG>(value) < static_cast<PY_LONG_LONG>(std::numeric_limits<T>::min());
+            }
+            return static_cast<unsigned PY_LONG_LONG>(value) > static_cast<unsigned PY_LONG_LONG>(std::numeric_limits<T>::max());
+        }
+    };
+
+    template <typename T, typename Source>
+    struct NumberRange<T, Source, true, false>
+    {
+        static inline bool overflows(Source value)
+        {
+            // The bounds are powers of two, so they are exact doubles. NaN overflows too.
+            double limit = std::ldexp(1.0, std::numeric_limits<T>::digits);
+            double truncated = value < 0 ? std::ceil(value) : std::floor(value);
+            return !(truncated < limit && truncated >= (std::numeric_limits<T>::is_signed ? -limit : 0.0));
+        }
+    };
+
+    /**
+     * Reads the numbers of a one dimensional block of memory exported through the new buffer
+     * protocol, or by an array.array, converting each of them to the type requested.
+     */
+    class LIBSHIBOKEN_API NumberReader
+    {
+    public:
+        /// Creates a null reader, to be opened later.
+        NumberReader();
+        ~NumberReader();
+
+        /// Opens the numbers of \p pyObj. Returns false with a Python error set if it fails.
+        bool open(PyObject* pyObj);
+
+        bool isNull() const { return !m_format; }
+        Py_ssize_t count() const { return m_count; }
+
+        /**
+         * Returns the number at \p index, which must be inside the bounds, converted to T as for
+         * an argument of that type. If T can't hold the number, an OverflowError is set and T()
+         * is returned, so callers check PyErr_Occurred() after reading.
+         */
+        template <typename T>
+        T at(Py_ssize_t index) const
+        {
+            const char* item = m_data + index * m_stride;
+            switch (m_format) {
+                case 'b': return cast<T>(read<signed char>(item));
+                case 'B': return cast<T>(read<unsigned char>(item));
+                case 'h': return cast<T>(read<short>(item));
+                case 'H': return cast<T>(read<unsigned short>(item));
+                case 'i': return cast<T>(read<int>(item));
+                case 'I': return cast<T>(read<unsigned int>(item));
+                case 'l': return cast<T>(read<long>(item));
+                case 'L': return cast<T>(read<unsigned long>(item));
+                case 'q': return cast<T>(read<PY_LONG_LONG>(item));
+                case 'Q': return cast<T>(read<unsigned PY_LONG_LONG>(item));
+                case 'f': return cast<T>(read<float>(item));
+                case 'd': return cast<T>(read<double>(item));
+                case '?': return cast<T>(read<bool>(item));
+                default: return T();
+            }
+        }
+
+        /**
+         * Opens \p readers for the \p count arguments in the \p args tuple of the function
+         * \p funcName, and returns their common number of items, or -1 with a Python error set
+         * if the arguments aren't \p count buffers with the same number of items.
+         */
+        static Py_ssize_t openAll(NumberReader* readers, int count, PyObject* args, const char* funcName);
+
+    private:
+        NumberReader(const NumberReader&);
+        NumberReader& operator=(const NumberReader&);
+
+        bool setFormat(const char* format, Py_ssize_t itemSize);
+
+        template <typename T, typename Source>
+        static T cast(Source value)
+        {
+            if (NumberRange<T, Source>::overflows(value)) {
+                PyErr_SetObject(PyExc_OverflowError, 0);
+                return T();
+            }
+            return static_cast<T>(value);
+        }
+
+        template <typename T>
+        static T read(const char* item)
+        {
+            // Strided items aren't necessarily aligned.
+            T value;
+            std::memcpy(&value, item, sizeof(T));
+            return value;
+        }
+
+        const char* m_data;
+        Py_ssize_t m_count;
+        Py_ssize_t m_stride;
+        char m_format;
+        PyObject* m_object;
+        Py_buffer m_view;
+        bool m_hasView;
+    };
+
 } // namespace Buffer
 } // namespace Shiboken
 
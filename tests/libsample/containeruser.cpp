@@ -0,0 +1,98 @@
+/*
+ * This file is part of the Shiboken Python Binding Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "containeruser.h"
+
+std::vector<int>
+ContainerUser::createVector(int size)
+{
+    std::vector<int> result;
+    for (int i = 0; i < size; ++i)
+        result.push_back(i);
+    return result;
+}
+
+std::vector<char>
+ContainerUser::letters(int count)
+{
+    std::vector<char> result;
+    for (int i = 0; i < count; ++i)
+        result.push_back('a' + i % 26);
+    return result;
+}
+
+int
+ContainerUser::sumVector(const std::vector<int>& values)
+{
+    int result = 0;
+    for (std::vector<int>::const_iterator it = values.begin(); it != values.end(); ++it)
+        result += *it;
+    return result;
+}
+
+double
+ContainerUser::sumDoubleVector(const std::vector<double>& values)
+{
+    double result = 0.0;
+    for (std::vector<double>::const_iterator it = values.begin(); it != values.end(); ++it)
+        result += *it;
+    return result;
+}
+
+std::list<bool>
+ContainerUser::negatedList(const std::list<bool>& values)
+{
+    std::list<bool> result;
+    for (std::list<bool>::const_iterator it = values.begin(); it != values.end(); ++it)
+        result.push_back(!*it);
+    return result;
+}
+
+std::deque<int>
+ContainerUser::reversedDeque(const std::deque<int>& values)
+{
+    return std::deque<int>(values.rbegin(), values.rend());
+}
+
+std::set<int>
+ContainerUser::uniqueValues(const std::list<int>& values)
+{
+    return std::set<int>(values.begin(), values.end());
+}
+
+int
+ContainerUser::sumSet(const std::set<int>& values)
+{
+    int result = 0;
+    for (std::set<int>::const_iterator it = values.begin(); it != values.end(); ++it)
+        result += *it;
+    return result;
+}
+
+std::map<int, int>
+ContainerUser::invertedMap(const std::map<int, int>& values)
+{
+    std::map<int, int> result;
+    for (std::map<int, int>::const_iterator it = values.begin(); it != values.end(); ++it)
+        result[it->second] = it->first;
+    return result;
+}
@@ -0,0 +1,52 @@
+/*
+ * This file is part of the Shiboken Python Binding Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef CONTAINERUSER_H
+#define CONTAINERUSER_H
+
+#include <deque>
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+#include "libsamplemacros.h"
+
+// Uses the STL containers that have no dedicated test class.
+class LIBSAMPLE_API ContainerUser
+{
+public:
+    static std::vector<int> createVector(int size);
+    static std::vector<char> letters(int count);
+    static int sumVector(const std::vector<int>& values);
+    static double sumDoubleVector(const std::vector<double>& values);
+
+    static std::list<bool> negatedList(const std::list<bool>& values);
+
+    static std::deque<int> reversedDeque(const std::deque<int>& values);
+
+    static std::set<int> uniqueValues(const std::list<int>& values);
+    static int sumSet(const std::set<int>& values);
+
+    static std::map<int, int> invertedMap(const std::map<int, int>& values);
+};
+
+#endif // CONTAINERUSER_H
@@ -0,0 +1,62 @@
+/*
+ * This file is part of the Shiboken Python Binding Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "copycounter.h"
+
+int CopyCounter::m_copies = 0;
+
+CopyCounter::CopyCounter(const CopyCounter& other) : m_value(other.m_value)
+{
+    m_copies++;
+}
+
+CopyCounter&
+CopyCounter::operator=(const CopyCounter& other)
+{
+    m_value = other.m_value;
+    m_copies++;
+    return *this;
+}
+
+CopyCounter
+CopyCounter::create(int value)
+{
+    return CopyCounter(value);
+}
+
+CopyCounter
+CopyCounter::doubled() const
+{
+    return CopyCounter(m_value * 2);
+}
+
+int
+CopyCounter::copies()
+{
+    return m_copies;
+}
+
+void
+CopyCounter::resetCopies()
+{
+    m_copies = 0;
+}
@@ -0,0 +1,50 @@
+/*
+ * This file is part of the Shiboken Python Binding Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef COPYCOUNTER_H
+#define COPYCOUNTER_H
+
+#include "libsamplemacros.h"
+
+// Value type that counts how many times its instances were copied.
+class LIBSAMPLE_API CopyCounter
+{
+public:
+    explicit CopyCounter(int value = 0) : m_value(value) {}
+    CopyCounter(const CopyCounter& other);
+    CopyCounter& operator=(const CopyCounter& other);
+
+    inline int value() const { return m_value; }
+
+    // Return by value, so the copies made by the binding can be counted.
+    static CopyCounter create(int value);
+    CopyCounter doubled() const;
+
+    static int copies();
+    static void resetCopies();
+
+private:
+    int m_value;
+    static int m_copies;
+};
+
+#endif // COPYCOUNTER_H
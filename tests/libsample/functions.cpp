@@ -178,3 +178,23 @@ acceptOddBoolReference(OddBool& x)
 {
     return x;
 }
+
+Str*
+returnStrPointer(Str* str)
+{
+    return str;
+}
+
+static Str* storedStrPointer = 0;
+
+void
+storeStrPointer(Str* str)
+{
+    storedStrPointer = str;
+}
+
+Str
+storedStr()
+{
+    return storedStrPointer ? *storedStrPointer : Str();
+}
@@ -29,6 +29,7 @@
 #include "oddbool.h"
 #include "complex.h"
 #include "objecttype.h"
+#include "str.h"
 
 enum GlobalEnum {
     NoThing,
@@ -73,4 +74,8 @@ LIBSAMPLE_API double acceptDouble(double x);
 LIBSAMPLE_API int acceptIntReference(int& x);
 LIBSAMPLE_API OddBool acceptOddBoolReference(OddBool& x);
 
+LIBSAMPLE_API Str* returnStrPointer(Str* str);
+LIBSAMPLE_API void storeStrPointer(Str* str);
+LIBSAMPLE_API Str storedStr();
+
 #endif // FUNCTIONS_H
@@ -0,0 +1,55 @@
+/*
+ * This file is part of the Shiboken Python Binding Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "image.h"
+
+Image::Image(int width, int height)
+    : m_width(width), m_height(height), m_pixels(width * height, 0)
+{
+}
+
+int
+Image::pixel(int x, int y) const
+{
+    return m_pixels[y * m_width + x];
+}
+
+void
+Image::setPixel(int x, int y, int value)
+{
+    m_pixels[y * m_width + x] = value;
+}
+
+std::vector<int>
+Image::histogram() const
+{
+    std::vector<int> result(256, 0);
+    for (std::vector<unsigned char>::const_iterator it = m_pixels.begin(); it != m_pixels.end(); ++it)
+        result[*it]++;
+    return result;
+}
+
+unsigned char*
+Image::bits()
+{
+    return m_pixels.empty() ? 0 : &m_pixels[0];
+}
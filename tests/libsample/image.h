@@ -0,0 +1,53 @@
+/*
+ * This file is part of the Shiboken Python Binding Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <vector>
+#include "libsamplemacros.h"
+
+// Grayscale image exported to Python through the buffer protocol.
+class LIBSAMPLE_API Image
+{
+public:
+    explicit Image(int width = 0, int height = 0);
+
+    inline int width() const { return m_width; }
+    inline int height() const { return m_height; }
+
+    int pixel(int x, int y) const;
+    void setPixel(int x, int y, int value);
+
+    // Pixels are stored row by row, one byte each.
+    unsigned char* bits();
+
+    // Number of pixels with each of the 256 gray levels.
+    std::vector<int> histogram() const;
+
+private:
+    int m_width;
+    int m_height;
+    std::vector<unsigned char> m_pixels;
+};
+
+#endif // IMAGE_H
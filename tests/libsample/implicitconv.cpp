@@ -58,3 +58,14 @@ ImplicitConv::implicitConvOverloading(CtorEnum dummyArg)
     return ImplicitConv::OverFunc_C;
 }
 
+ImplicitConv
+ImplicitConv::implicitConvTagged(ImplicitConv implicit, int tag)
+{
+    return implicit;
+}
+
+ImplicitConv
+ImplicitConv::implicitConvTagged(ImplicitConv implicit, bool tag)
+{
+    return implicit;
+}
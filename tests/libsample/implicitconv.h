@@ -46,6 +46,8 @@ public:
     };
 
     ImplicitConv() : m_ctorEnum(CtorNone), m_objId(-1), m_value(-1.0) {}
+    // Removed in the binding, so it is not an implicit conversion there.
+    ImplicitConv(const char*) : m_ctorEnum(CtorNone), m_objId(-1), m_value(-1.0) {}
     ImplicitConv(int objId) : m_ctorEnum(CtorOne), m_objId(objId), m_value(-1.0) {}
     ImplicitConv(CtorEnum ctorEnum) : m_ctorEnum(ctorEnum), m_objId(-1), m_value(-1.0) {}
     ImplicitConv(ObjectType&) : m_ctorEnum(CtorObjectTypeReference), m_objId(-1), m_value(-1.0) {}
@@ -65,6 +67,9 @@ public:
     static ICOverloadedFuncEnum implicitConvOverloading(int dummyArg);
     static ICOverloadedFuncEnum implicitConvOverloading(CtorEnum dummyArg);
 
+    static ImplicitConv implicitConvTagged(ImplicitConv implicit, int tag);
+    static ImplicitConv implicitConvTagged(ImplicitConv implicit, bool tag);
+
 private:
     CtorEnum m_ctorEnum;
     int m_objId;
@@ -83,3 +83,10 @@ ListUser::multiplyPointList(PointList& points, double multiplier)
     }
 }
 
+void
+ListUser::multiplyList(std::list<int>& values, int multiplier)
+{
+    for(std::list<int>::iterator it = values.begin(); it != values.end(); it++)
+        *it *= multiplier;
+}
+
@@ -56,6 +56,7 @@ public:
     static ListOfSomething listOfPoints(const std::list<PointF>& pointlist);
 
     static void multiplyPointList(PointList& points, double multiplier);
+    static void multiplyList(std::list<int>& values, int multiplier);
 
     inline void setList(std::list<int> lst) { m_lst = lst; }
     inline std::list<int> getList() { return m_lst; }
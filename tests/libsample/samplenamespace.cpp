@@ -75,6 +75,17 @@ doSomethingWithArray(const unsigned char* data, unsigned int size, const char* f
     // to check compilation issues, i.e. if it compiles, it's ok.
 }
 
+int
+countCharacter(const char* data, int size, char character)
+{
+    int count = 0;
+    for (int i = 0; i < size; ++i) {
+        if (data[i] == character)
+            ++count;
+    }
+    return count;
+}
+
 int
 enumItemAsDefaultValueToIntArgument(int value)
 {
@@ -85,6 +85,9 @@ inline double powerOfTwo(double num) {
 
 LIBSAMPLE_API void doSomethingWithArray(const unsigned char* data, unsigned int size, const char* format = 0);
 
+// Counts the occurrences of a character in a block of bytes that may hold embedded null characters.
+LIBSAMPLE_API int countCharacter(const char* data, int size, char character);
+
 LIBSAMPLE_API int enumItemAsDefaultValueToIntArgument(int value = ZeroIn);
 
 class SomeClass
@@ -0,0 +1,44 @@
+/*
+ * This file is part of the Shiboken Python Binding Generator project.
+ *
+ * Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+ *
+ * Contact: PySide team <contact@pyside.org>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SHAPE_H
+#define SHAPE_H
+
+#include "libsamplemacros.h"
+
+// Polymorphic class used to check when the binding instantiates its C++ wrapper.
+class LIBSAMPLE_API Shape
+{
+public:
+    explicit Shape(int sides = 0) : m_sides(sides) {}
+    virtual ~Shape();
+
+    virtual int sides() const;
+    // Calls the virtual method from C++.
+    int callSides() const { return sides(); }
+
+private:
+    int m_sides;
+};
+
+#endif // SHAPE_H
+
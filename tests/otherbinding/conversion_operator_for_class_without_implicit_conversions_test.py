@@ -30,7 +30,7 @@
 
 import unittest
 
-from sample import NoImplicitConversion
+from sample import NoImplicitConversion, Point
 from other import ExtendsNoImplicitConversion
 
 class ConversionOperatorForClassWithoutImplicitConversionsTest(unittest.TestCase):
@@ -62,6 +62,27 @@ class ConversionOperatorForClassWithoutImplicitConversionsTest(unittest.TestCase
         obj = ExtendsNoImplicitConversion(123)
         self.assertRaises(TypeError, NoImplicitConversion.receivesNoImplicitConversionByPointer, obj)
 
+    def testRepeatedExternalConversions(self):
+        '''Repeats the external conversion, whose decision is kept after the first call.'''
+        obj = ExtendsNoImplicitConversion(123)
+        for i in range(3):
+            self.assertEqual(obj.objId(), NoImplicitConversion.receivesNoImplicitConversionByValue(obj))
+            self.assertRaises(TypeError, NoImplicitConversion.receivesNoImplicitConversionByPointer, obj)
+
+    def testExternalConversionOfSubclass(self):
+        '''Gives an instance of a Python subclass of ExtendsNoImplicitConversion to a function expecting a NoImplicitConversion.'''
+        class ExtendsNoImplicitConversionSubclass(ExtendsNoImplicitConversion):
+            pass
+        obj = ExtendsNoImplicitConversionSubclass(123)
+        self.assertEqual(obj.objId(), NoImplicitConversion.receivesNoImplicitConversionByValue(obj))
+        self.assertEqual(obj.objId(), NoImplicitConversion.receivesNoImplicitConversionByReference(obj))
+
+    def testRepeatedRejectedExternalConversions(self):
+        '''Repeats a call with a wrapper that has no conversion to NoImplicitConversion.'''
+        obj = Point()
+        for i in range(3):
+            self.assertRaises(TypeError, NoImplicitConversion.receivesNoImplicitConversionByValue, obj)
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for the static methods reading a getter over sequences of objects.'''
+
+import array
+import unittest
+
+from sample import Point, Polygon, Shape, Size
+
+class ArrayGetterTest(unittest.TestCase):
+    '''Test case for getters projected over sequences into arrays.'''
+
+    def testPolygonPoints(self):
+        polygon = Polygon([Point(i, i * 2) for i in range(100)])
+        xs = Point.xArray(polygon.points())
+        ys = Point.yArray(polygon.points())
+        self.assertEqual(len(xs), 100)
+        self.assertEqual(list(xs), [float(i) for i in range(100)])
+        self.assertEqual(list(ys), [float(i * 2) for i in range(100)])
+
+    def testBufferProtocol(self):
+        xs = Point.xArray((Point(1.5, 0), Point(2.5, 0)))
+        view = memoryview(xs)
+        self.assertEqual(view.format, 'd')
+        self.assertEqual(array.array('d', view.tobytes()).tolist(), [1.5, 2.5])
+        self.assertEqual(xs.__array_interface__['shape'], (2,))
+
+    def testClassOption(self):
+        '''All the numeric getters of a listed class get their array method.'''
+        sizes = [Size(2, 3), Size(4, 5)]
+        self.assertEqual(list(Size.widthArray(sizes)), [2.0, 4.0])
+        self.assertEqual(list(Size.heightArray(sizes)), [3.0, 5.0])
+        self.assertEqual(list(Size.calculateAreaArray(sizes)), [6.0, 20.0])
+
+    def testNonNumericGetter(self):
+        '''Getters returning objects don't get array methods.'''
+        self.assertFalse(hasattr(Point, 'copyArray'))
+        self.assertFalse(hasattr(Point, 'getSelfArray'))
+
+    def testEmptySequence(self):
+        self.assertEqual(len(Point.xArray([])), 0)
+
+    def testInvalidItems(self):
+        self.assertRaises(TypeError, Point.xArray, [Point(), Size()])
+        self.assertRaises(TypeError, Point.xArray, 10)
+
+    def testVirtualGetter(self):
+        '''A getter overridden in Python is called for every item.'''
+        class Triangle(Shape):
+            def sides(self):
+                return 3
+        self.assertEqual(list(Shape.sidesArray([Shape(4), Triangle()])), [4, 3])
+
+    def testFailingVirtualGetter(self):
+        '''An error in a Python override of the getter is raised instead of giving an array.'''
+        class Broken(Shape):
+            def sides(self):
+                return 2**40
+        self.assertRaises(OverflowError, Shape.sidesArray, [Shape(4), Broken(), Shape(5)])
+
+if __name__ == '__main__':
+    unittest.main()
+
@@ -0,0 +1,124 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for the array interface of C++ numeric storage, without NumPy.'''
+
+import array
+import ctypes
+import sys
+import unittest
+
+from sample import ContainerUser, Image
+
+class ArrayInterfaceStruct(ctypes.Structure):
+    '''PyArrayInterface structure wrapped by __array_struct__.'''
+    _fields_ = [('two', ctypes.c_int), ('nd', ctypes.c_int), ('typekind', ctypes.c_char),
+                ('itemsize', ctypes.c_int), ('flags', ctypes.c_int),
+                ('shape', ctypes.POINTER(ctypes.c_ssize_t)), ('strides', ctypes.POINTER(ctypes.c_ssize_t)),
+                ('data', ctypes.c_void_p), ('descr', ctypes.c_void_p)]
+
+def readArrayStruct(pyObj):
+    '''Returns the PyArrayInterface structure wrapped by pyObj.'''
+    asVoidPtr = ctypes.pythonapi.PyCObject_AsVoidPtr
+    asVoidPtr.restype = ctypes.c_void_p
+    asVoidPtr.argtypes = [ctypes.py_object]
+    return ArrayInterfaceStruct.from_address(asVoidPtr(pyObj))
+
+def toArray(pyObj, typecode):
+    '''Local array consumer, copies the memory described by __array_interface__ to an array.'''
+    interface = pyObj.__array_interface__
+    result = array.array(typecode)
+    size = result.itemsize
+    for dimension in interface['shape']:
+        size *= dimension
+    result.fromstring(ctypes.string_at(interface['data'][0], size))
+    return result
+
+class ImageArrayInterfaceTest(unittest.TestCase):
+    '''Test case for the array interface of a buffer exporter.'''
+
+    def testArrayInterface(self):
+        image = Image(3, 2)
+        image.setPixel(2, 0, 200)
+        interface = image.__array_interface__
+        self.assertEqual(interface['version'], 3)
+        self.assertEqual(interface['shape'], (2, 3))
+        self.assertEqual(interface['strides'], (3, 1))
+        self.assertEqual(interface['typestr'], '|u1')
+        self.assertFalse(interface['data'][1])
+        self.assertEqual(toArray(image, 'B').tolist(), [0, 0, 200, 0, 0, 0])
+
+    def testArrayStruct(self):
+        image = Image(3, 2)
+        refCount = sys.getrefcount(image)
+        arrayStruct = image.__array_struct__
+        # The structure keeps the image alive.
+        self.assertEqual(sys.getrefcount(image), refCount + 1)
+        info = readArrayStruct(arrayStruct)
+        self.assertEqual(info.two, 2)
+        self.assertEqual(info.nd, 2)
+        self.assertEqual(info.typekind, 'u')
+        self.assertEqual(info.itemsize, 1)
+        self.assertEqual((info.shape[0], info.shape[1]), (2, 3))
+        self.assertEqual(info.data, image.__array_interface__['data'][0])
+        del arrayStruct
+        self.assertEqual(sys.getrefcount(image), refCount)
+
+class ArrayReturnTest(unittest.TestCase):
+    '''Test case for vectors of numbers returned as arrays.'''
+
+    def testHistogram(self):
+        image = Image(2, 2)
+        image.setPixel(0, 0, 3)
+        image.setPixel(1, 1, 3)
+        histogram = image.histogram()
+        self.assertEqual(len(histogram), 256)
+        self.assertEqual(histogram[0], 2)
+        self.assertEqual(histogram[3], 2)
+        self.assertEqual([value for value in histogram][:4], [2, 0, 0, 2])
+
+    def testZeroCopyConsumers(self):
+        histogram = Image(1, 1).histogram()
+        interface = histogram.__array_interface__
+        self.assertEqual(interface['shape'], (256,))
+        self.assertEqual(interface['typestr'][1:], 'i%d' % array.array('i').itemsize)
+        self.assertEqual(toArray(histogram, 'i')[0], 1)
+        view = memoryview(histogram)
+        self.assertEqual(view.format, 'i')
+        self.assertEqual(view.shape, (256,))
+        self.assertEqual(array.array('i', histogram)[0], 1)
+
+    def testCharItems(self):
+        '''Vectors of char export one byte strings, as their items are converted.'''
+        letters = ContainerUser.letters(3)
+        self.assertEqual(list(letters), ['a', 'b', 'c'])
+        view = memoryview(letters)
+        self.assertEqual(view.format, 'c')
+        self.assertEqual(view.tobytes(), 'abc')
+        self.assertEqual(letters.__array_interface__['typestr'], '|S1')
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,67 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for functions that read the bytes of strings and buffers without copies.'''
+
+import array
+import unittest
+
+from sample import SampleNamespace
+
+class ByteViewArgumentTest(unittest.TestCase):
+    '''Test case for const char* arguments taking string and buffer bytes.'''
+
+    def testString(self):
+        '''Strings are read with their embedded null characters.'''
+        self.assertEqual(SampleNamespace.countCharacter('a\x00b\x00a', 'a'), 2)
+        self.assertEqual(SampleNamespace.countCharacter('a\x00b\x00a', '\x00'), 2)
+
+    def testEmptyString(self):
+        self.assertEqual(SampleNamespace.countCharacter('', 'a'), 0)
+
+    def testByteArray(self):
+        data = bytearray('abracadabra')
+        self.assertEqual(SampleNamespace.countCharacter(data, 'a'), 5)
+
+    def testBuffer(self):
+        self.assertEqual(SampleNamespace.countCharacter(buffer('abracadabra', 1, 4), 'a'), 1)
+
+    def testMemoryView(self):
+        self.assertEqual(SampleNamespace.countCharacter(memoryview('abracadabra'), 'r'), 2)
+
+    def testArray(self):
+        data = array.array('c', 'banana')
+        self.assertEqual(SampleNamespace.countCharacter(data, 'n'), 2)
+
+    def testUnicode(self):
+        self.assertRaises(TypeError, SampleNamespace.countCharacter, u'abc', 'a')
+
+    def testInvalidType(self):
+        self.assertRaises(TypeError, SampleNamespace.countCharacter, 123, 'a')
+
+if __name__ == '__main__':
+    unittest.main()
+
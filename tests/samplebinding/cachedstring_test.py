@@ -0,0 +1,77 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for functions returning strings through the cache of short strings.'''
+
+import atexit
+import sys
+import unittest
+
+from sample import Derived, ObjectTypeOperators
+
+class CachedStringReturnTest(unittest.TestCase):
+    '''Test case for const char* and std::string returns reusing Python strings.'''
+
+    def testCString(self):
+        '''Repeated C strings give the same Python string.'''
+        d = Derived()
+        self.assertEqual(d.className(), 'Derived')
+        self.assertTrue(d.className() is Derived().className())
+        self.assertTrue(d.getClassName() is d.className())
+
+    def testStdString(self):
+        '''Repeated std::string contents give the same Python string.'''
+        first = ObjectTypeOperators('attribute')
+        second = ObjectTypeOperators('attribute')
+        self.assertEqual(first.key(), 'attribute')
+        self.assertTrue(first.key() is second.key())
+
+    def testDifferentContents(self):
+        first = ObjectTypeOperators('tag')
+        second = ObjectTypeOperators('other')
+        self.assertEqual(first.key(), 'tag')
+        self.assertEqual(second.key(), 'other')
+
+    def testLongString(self):
+        '''Long strings are not kept by the cache, but still converted.'''
+        key = 'x' * 1000
+        self.assertEqual(ObjectTypeOperators(key).key(), key)
+
+    def testClearedAtExit(self):
+        '''The cache is released by a handler registered in the atexit module.'''
+        handlers = [func for func, args, kwargs in atexit._exithandlers
+                    if getattr(func, '__name__', None) == 'clearStringCache']
+        self.assertEqual(len(handlers), 1)
+        key = ObjectTypeOperators('released key').key()
+        refCount = sys.getrefcount(key)
+        handlers[0]()
+        self.assertEqual(sys.getrefcount(key), refCount - 1)
+        # The cache is filled again after being cleared.
+        self.assertTrue(ObjectTypeOperators('released key').key() is key)
+
+if __name__ == '__main__':
+    unittest.main()
+
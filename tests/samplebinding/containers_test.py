@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+
+'''Test cases for std::vector, std::deque, std::set and std::map conversions.'''
+
+import unittest
+
+from sample import ContainerUser
+
+class ContainerConversionTest(unittest.TestCase):
+    '''Test case for the conversion of STL containers from and to Python.'''
+
+    def testVector(self):
+        '''std::vector is converted from and to Python lists.'''
+        self.assertEqual(ContainerUser.createVector(4), [0, 1, 2, 3])
+        self.assertEqual(ContainerUser.sumVector(range(10)), 45)
+        self.assertEqual(ContainerUser.sumVector((1, 2, 3)), 6)
+
+    def testDeque(self):
+        '''std::deque is converted from and to Python lists.'''
+        self.assertEqual(ContainerUser.reversedDeque([1, 2, 3]), [3, 2, 1])
+        self.assertEqual(ContainerUser.reversedDeque(()), [])
+
+    def testSetReturn(self):
+        '''std::set is returned as a Python set.'''
+        result = ContainerUser.uniqueValues([3, 1, 3, 2, 1])
+        self.assertEqual(type(result), set)
+        self.assertEqual(result, set([1, 2, 3]))
+
+    def testSetArgument(self):
+        '''std::set accepts sets, frozensets and sequences.'''
+        self.assertEqual(ContainerUser.sumSet(set([1, 2, 3])), 6)
+        self.assertEqual(ContainerUser.sumSet(frozenset([4, 5])), 9)
+        self.assertEqual(ContainerUser.sumSet([1, 1, 2]), 3)
+
+    def testLargeSet(self):
+        '''Large sets are built after the conversion of all their items.'''
+        values = range(5000) * 2
+        self.assertEqual(ContainerUser.sumSet(values), sum(range(5000)))
+        self.assertEqual(ContainerUser.uniqueValues(values), set(values))
+
+    def testLargeSetArgument(self):
+        '''A set at least as large as the GIL release threshold is converted.'''
+        self.assertEqual(ContainerUser.sumSet(set(range(1024))), sum(range(1024)))
+
+    def testMap(self):
+        '''std::map is converted from and to Python dictionaries.'''
+        self.assertEqual(ContainerUser.invertedMap({1 : 10, 2 : 20}), {10 : 1, 20 : 2})
+        self.assertEqual(ContainerUser.invertedMap({}), {})
+
+    def testLargeMap(self):
+        '''Maps above the GIL release threshold are built after the conversion of all their items.'''
+        values = dict((i, 3 * i) for i in range(5000))
+        self.assertEqual(ContainerUser.invertedMap(values), dict((3 * i, i) for i in range(5000)))
+
+    def testInvalidSet(self):
+        '''std::set rejects items of the wrong type.'''
+        self.assertRaises(TypeError, ContainerUser.sumSet, set(['a', 'b']))
+
+if __name__ == '__main__':
+    unittest.main()
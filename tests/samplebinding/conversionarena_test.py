@@ -0,0 +1,74 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for temporaries created by implicit conversions of reference arguments.'''
+
+import unittest
+
+from sample import ObjectModel, ObjectView, Str, returnStrPointer, storeStrPointer, storedStr
+
+class ConversionArenaTest(unittest.TestCase):
+    '''Test case for implicit conversions of non-const reference arguments.'''
+
+    def testImplicitConversionToReference(self):
+        '''Passes a Python string where a non-const reference to Str is expected.'''
+        model = ObjectModel()
+        view = ObjectView(model)
+        view.modifyModelData('the name')
+        self.assertEqual(model.objectName(), 'the name')
+
+    def testWrappedObjectAsReference(self):
+        '''Passes a wrapped Str where a non-const reference to Str is expected.'''
+        model = ObjectModel()
+        view = ObjectView(model)
+        name = Str('wrapped name')
+        view.modifyModelData(name)
+        self.assertEqual(model.objectName(), 'wrapped name')
+        self.assertEqual(name, 'wrapped name')
+
+    def testManyImplicitConversions(self):
+        '''Calls a function many times with implicitly converted arguments.'''
+        model = ObjectModel()
+        view = ObjectView(model)
+        for i in range(1000):
+            view.modifyModelData('name %d' % i)
+        self.assertEqual(model.objectName(), 'name 999')
+
+    def testReturnedArgument(self):
+        '''A function returning its implicitly converted pointer argument gives a valid object.'''
+        results = [returnStrPointer('string %d' % i) for i in range(100)]
+        self.assertEqual([str(result) for result in results], ['string %d' % i for i in range(100)])
+
+    def testStoredArgument(self):
+        '''A free function storing its implicitly converted pointer argument keeps a valid object.'''
+        storeStrPointer('stored string')
+        for i in range(100):
+            returnStrPointer('string %d' % i)
+        self.assertEqual(storedStr(), 'stored string')
+
+if __name__ == '__main__':
+    unittest.main()
+
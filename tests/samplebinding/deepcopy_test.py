@@ -0,0 +1,112 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for the native __deepcopy__ and copyList of value types.'''
+
+import copy
+import unittest
+
+from sample import Point, PointF, Size, SizeF
+
+class ExtendedPoint(Point):
+    pass
+
+class DeepCopyTest(unittest.TestCase):
+    '''Test case for __deepcopy__ of value types.'''
+
+    def testDeepCopy(self):
+        pt = Point(1, 2)
+        result = copy.deepcopy(pt)
+        self.assertEqual(result, pt)
+        self.assertFalse(result is pt)
+        result.setX(10)
+        self.assertEqual(pt, Point(1, 2))
+
+    def testMemo(self):
+        '''Repeated references to the same value are copied once.'''
+        pt = Point(3, 4)
+        result = copy.deepcopy({'a': pt, 'b': [pt, (pt, Size(5, 6))]})
+        self.assertTrue(result['a'] is result['b'][0])
+        self.assertTrue(result['a'] is result['b'][1][0])
+        self.assertFalse(result['a'] is pt)
+        self.assertEqual(result['b'][1][1].width(), 5)
+
+    def testInlineStorage(self):
+        pt = PointF(1.5, 2.5)
+        result = copy.deepcopy(pt)
+        self.assertEqual((result.x(), result.y()), (1.5, 2.5))
+
+    def testSubclass(self):
+        '''Python subclasses keep their class and get a deep copy of their attributes.'''
+        pt = ExtendedPoint(5, 6)
+        pt.tags = ['corner', ['nested']]
+        pt.self = pt
+        result = copy.deepcopy(pt)
+        self.assertEqual(type(result), ExtendedPoint)
+        self.assertEqual(result, Point(5, 6))
+        self.assertEqual(result.tags, pt.tags)
+        self.assertFalse(result.tags[1] is pt.tags[1])
+        self.assertTrue(result.self is result)
+
+    def testTypeSystemDeepCopy(self):
+        '''A __deepcopy__ written in the type system takes precedence.'''
+        size = SizeF(1.5, 2.5)
+        self.assertTrue(copy.deepcopy(size) is size)
+        result = SizeF.copyList([size])
+        self.assertFalse(result[0] is size)
+        self.assertEqual((result[0].width(), result[0].height()), (1.5, 2.5))
+
+class CopyListTest(unittest.TestCase):
+    '''Test case for the copyList static method.'''
+
+    def testCopyList(self):
+        points = [Point(i, i) for i in range(50)]
+        result = Point.copyList(points)
+        self.assertEqual(result, points)
+        for original, item in zip(points, result):
+            self.assertFalse(original is item)
+
+    def testTuple(self):
+        self.assertEqual(Point.copyList((Point(1, 1),)), [Point(1, 1)])
+
+    def testSubclassItems(self):
+        '''Instances of subclasses keep their class and attributes.'''
+        pt = ExtendedPoint(1, 2)
+        pt.label = ['corner']
+        result = Point.copyList([Point(0, 0), pt])
+        self.assertEqual(type(result[0]), Point)
+        self.assertEqual(type(result[1]), ExtendedPoint)
+        self.assertEqual(result[1], Point(1, 2))
+        self.assertEqual(result[1].label, ['corner'])
+        self.assertFalse(result[1].label is pt.label)
+
+    def testInvalidItems(self):
+        self.assertRaises(TypeError, Point.copyList, [Point(), Size()])
+        self.assertRaises(TypeError, Point.copyList, None)
+
+if __name__ == '__main__':
+    unittest.main()
+
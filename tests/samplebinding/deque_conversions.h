@@ -0,0 +1,4 @@
+namespace Shiboken {
+template<typename T>
+struct Converter<std::deque<T> > : StdListConverter<std::deque<T> > {};
+}
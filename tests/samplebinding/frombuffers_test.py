@@ -0,0 +1,91 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for building sequences of value types from buffers of numbers.'''
+
+import array
+import unittest
+
+from sample import Point, Polygon, Rect, Size
+
+class FromBuffersTest(unittest.TestCase):
+    '''Test case for the fromBuffers static method.'''
+
+    def testArrays(self):
+        xs = array.array('d', [1.5, 2.5, 3.5])
+        ys = array.array('i', [4, 5, 6])
+        points = Point.fromBuffers(xs, ys)
+        self.assertEqual(len(points), 3)
+        self.assertEqual(points[0], Point(1.5, 4.0))
+        self.assertEqual(points[2], Point(3.5, 6.0))
+
+    def testFloatingPointConstructor(self):
+        '''The constructor taking doubles is used over the one taking ints.'''
+        points = Point.fromBuffers(array.array('d', [0.5]), array.array('d', [0.25]))
+        self.assertEqual(points[0].x(), 0.5)
+        self.assertEqual(points[0].y(), 0.25)
+
+    def testByteBuffers(self):
+        sizes = Size.fromBuffers(bytearray('\x01\x02'), memoryview('\x03\x04'))
+        self.assertEqual([(s.width(), s.height()) for s in sizes], [(1.0, 3.0), (2.0, 4.0)])
+
+    def testIntegerConstructor(self):
+        '''Floating point items are truncated for integer arguments, as in Rect(1.5, ...).'''
+        rects = Rect.fromBuffers(array.array('d', [1.5, -2.5]), array.array('d', [2.0, 3.9]),
+                                 array.array('i', [3, 4]), array.array('h', [5, 6]))
+        self.assertEqual([(r.left(), r.top(), r.right(), r.bottom()) for r in rects],
+                         [(1, 2, 3, 5), (-2, 3, 4, 6)])
+
+    def testIntegerOverflow(self):
+        '''Items that don't fit in an integer argument raise OverflowError, as in Rect(1e10, ...).'''
+        self.assertRaises(OverflowError, Rect, 1e10, 0, 0, 0)
+        small = array.array('d', [0.0, 0.0])
+        self.assertRaises(OverflowError, Rect.fromBuffers,
+                          array.array('d', [1.0, 1e10]), small, small, small)
+        self.assertRaises(OverflowError, Rect.fromBuffers,
+                          array.array('I', [1, 2 ** 32 - 1]), small, small, small)
+
+    def testPassToCpp(self):
+        points = Point.fromBuffers(array.array('d', range(10)), array.array('d', range(10)))
+        polygon = Polygon(points)
+        self.assertEqual(len(polygon.points()), 10)
+        self.assertEqual(polygon.points()[9], Point(9.0, 9.0))
+
+    def testEmptyBuffers(self):
+        self.assertEqual(len(Point.fromBuffers(array.array('d'), array.array('d'))), 0)
+
+    def testDifferentLengths(self):
+        self.assertRaises(ValueError, Point.fromBuffers, array.array('d', [1, 2]), array.array('d', [1]))
+
+    def testUnsupportedFormat(self):
+        self.assertRaises(ValueError, Point.fromBuffers, array.array('c', 'ab'), array.array('d', [1, 2]))
+
+    def testInvalidArguments(self):
+        self.assertRaises(TypeError, Point.fromBuffers, array.array('d', [1]))
+        self.assertRaises(TypeError, Point.fromBuffers, [1.0], [2.0])
+
+if __name__ == '__main__':
+    unittest.main()
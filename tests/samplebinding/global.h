@@ -4,11 +4,14 @@
 #include "bucket.h"
 #include "collector.h"
 #include "complex.h"
+#include "containeruser.h"
+#include "copycounter.h"
 #include "ctorconvrule.h"
 #include "sbkdate.h"
 #include "derived.h"
 #include "echo.h"
 #include "functions.h"
+#include "image.h"
 #include "implicitconv.h"
 #include "overloadsort.h"
 #include "handle.h"
@@ -47,6 +50,7 @@
 #include "removednamespaces.h"
 #include "sample.h"
 #include "samplenamespace.h"
+#include "shape.h"
 #include "simplefile.h"
 #include "size.h"
 #include "str.h"
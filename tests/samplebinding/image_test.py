@@ -0,0 +1,63 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for classes exporting their memory through the buffer protocol.'''
+
+import struct
+import unittest
+
+from sample import Image
+
+class ImageBufferTest(unittest.TestCase):
+    '''Test case for the Image pixels exported as a buffer.'''
+
+    def testMemoryView(self):
+        '''memoryview sees the pixels as a two dimensional byte array.'''
+        image = Image(3, 2)
+        image.setPixel(1, 0, 7)
+        image.setPixel(2, 1, 9)
+        view = memoryview(image)
+        self.assertEqual(view.ndim, 2)
+        self.assertEqual(view.shape, (2, 3))
+        self.assertEqual(view.strides, (3, 1))
+        self.assertEqual(view.format, 'B')
+        self.assertFalse(view.readonly)
+        self.assertEqual(view.tobytes(), '\x00\x07\x00\x00\x00\x09')
+
+    def testLegacyBuffer(self):
+        '''Python 2 buffer consumers see the same memory.'''
+        image = Image(2, 2)
+        image.setPixel(0, 1, 5)
+        self.assertEqual(str(buffer(image)), '\x00\x00\x05\x00')
+
+    def testWriteThroughBuffer(self):
+        '''Writes through the buffer change the C++ object.'''
+        image = Image(2, 2)
+        struct.pack_into('B', image, 3, 42)
+        self.assertEqual(image.pixel(1, 1), 42)
+
+if __name__ == '__main__':
+    unittest.main()
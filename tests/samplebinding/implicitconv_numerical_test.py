@@ -130,5 +130,37 @@ class LongImplicitConvert(NumericTester):
         self.check_value(42l, 42, sample.acceptDouble, float)
 
 
+class ExactTypeConvert(NumericTester):
+    '''Test case for the conversions of bools and of subclasses of the numeric types.'''
+
+    def testBoolAsNumber(self):
+        '''Bool as Int, Long, unsigned Int and double'''
+        self.check_value(True, 1, sample.acceptInt, int)
+        self.check_value(False, 0, sample.acceptLong, int)
+        self.check_value(True, 1, sample.acceptUInt, long)
+        self.check_value(True, 1.0, sample.acceptDouble, float)
+
+    def testIntSubclass(self):
+        '''Subclass of int as Int and double'''
+        class MyInt(int):
+            pass
+        self.check_value(MyInt(7), 7, sample.acceptInt, int)
+        self.check_value(MyInt(7), 7.0, sample.acceptDouble, float)
+
+    def testFloatSubclass(self):
+        '''Subclass of float as double and Int'''
+        class MyFloat(float):
+            pass
+        self.check_value(MyFloat(2.5), 2.5, sample.acceptDouble, float)
+        self.check_value(MyFloat(2.5), 2, sample.acceptInt, int)
+
+    def testIntRange(self):
+        '''Ints at the limits of the C++ types'''
+        self.check_value(2**31 - 1, 2**31 - 1, sample.acceptInt, int)
+        self.assertRaises(OverflowError, sample.acceptInt, 2**31)
+        self.check_value(2**32 - 1, 2**32 - 1, sample.acceptUInt, long)
+        self.assertRaises(OverflowError, sample.acceptUInt, 2**32)
+
+
 if __name__ == '__main__':
     unittest.main()
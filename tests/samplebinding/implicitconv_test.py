@@ -53,6 +53,34 @@ class ImplicitConvTest(unittest.TestCase):
         ic = ImplicitConv.implicitConvCommon(42.42)
         self.assertEqual(ic.value(), 42.42)
 
+    def testRemovedImplicitConversion(self):
+        '''A constructor removed in the typesystem is not used as an implicit conversion.'''
+        self.assertRaises(TypeError, ImplicitConv, 'name')
+        self.assertRaises(TypeError, ImplicitConv.implicitConvCommon, 'name')
+
+    def testOverloadsDifferingInLaterArgument(self):
+        '''The conversion of the first argument found by the overload decisor is used by every overload.'''
+        self.assertEqual(ImplicitConv.implicitConvOverloading(ImplicitConv(), 1), ImplicitConv.OverFunc_Ii)
+        self.assertEqual(ImplicitConv.implicitConvOverloading(3, 1), ImplicitConv.OverFunc_Ii)
+        self.assertEqual(ImplicitConv.implicitConvOverloading(3, True), ImplicitConv.OverFunc_Ib)
+        self.assertEqual(ImplicitConv.implicitConvOverloading(3), ImplicitConv.OverFunc_i)
+
+        for tag in (7, False):
+            ic = ImplicitConv.implicitConvTagged(3, tag)
+            self.assertEqual(ic.ctorEnum(), ImplicitConv.CtorOne)
+            self.assertEqual(ic.objId(), 3)
+
+            ic = ImplicitConv.implicitConvTagged(ImplicitConv.CtorThree, tag)
+            self.assertEqual(ic.ctorEnum(), ImplicitConv.CtorThree)
+
+            ic = ImplicitConv.implicitConvTagged(ObjectType(), tag)
+            self.assertEqual(ic.ctorEnum(), ImplicitConv.CtorObjectTypeReference)
+
+            ic = ImplicitConv.implicitConvTagged(42.42, tag)
+            self.assertEqual(ic.value(), 42.42)
+
+        self.assertRaises(TypeError, ImplicitConv.implicitConvTagged, 'name', 1)
+
 if __name__ == '__main__':
     unittest.main()
 
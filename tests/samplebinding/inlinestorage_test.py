@@ -0,0 +1,87 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2010 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for value types that keep their C++ objects inside the Python wrappers.'''
+
+import copy
+import unittest
+
+from sample import Point, PointF, SizeF
+
+class ExtPointF(PointF):
+    def __init__(self, x, y):
+        PointF.__init__(self, x, y)
+        self.label = 'ext'
+
+class InlineStorageTest(unittest.TestCase):
+    '''Value types listed in the "inline-value-types" generator option.'''
+
+    def testWrapperSize(self):
+        '''Wrappers of inline value types reserve memory for the C++ object.'''
+        self.assert_(PointF.__basicsize__ > Point.__basicsize__)
+        self.assert_(SizeF.__basicsize__ > Point.__basicsize__)
+
+    def testConstructor(self):
+        pt = PointF(5.0, 2.3)
+        self.assertEqual(pt.x(), 5.0)
+        self.assertEqual(pt.y(), 2.3)
+        pt.setX(1.5)
+        self.assertEqual(pt.x(), 1.5)
+
+    def testReturnedValue(self):
+        '''Values returned by C++ are copied inside the new wrapper.'''
+        result = PointF(5.0, 2.3) + PointF(0.5, 3.2)
+        self.assertEqual(result, PointF(5.5, 5.5))
+
+    def testCopy(self):
+        pt = PointF(5.0, 2.3)
+        other = copy.copy(pt)
+        self.assert_(pt is not other)
+        self.assertEqual(pt, other)
+        other.setX(0.0)
+        self.assertEqual(pt.x(), 5.0)
+
+    def testInitializeTwice(self):
+        pt = PointF(5.0, 2.3)
+        self.assertRaises(RuntimeError, pt.__init__, 1.0, 1.0)
+        self.assertEqual(pt.x(), 5.0)
+
+    def testSubclass(self):
+        pt = ExtPointF(1.0, 2.0)
+        self.assertEqual(pt.label, 'ext')
+        self.assertEqual(pt, PointF(1.0, 2.0))
+        self.assertEqual(pt + pt, PointF(2.0, 4.0))
+
+    def testManyObjects(self):
+        points = [PointF(i, i) for i in range(1000)]
+        total = PointF()
+        for pt in points:
+            total += pt
+        self.assertEqual(total.x(), sum(range(1000)))
+        del points
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,107 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for maps returned as lazy mapping proxies.'''
+
+import unittest
+
+from sample import MapUser
+
+class LazyMapTest(unittest.TestCase):
+    '''Test case for the mapping proxy returned by MapUser.getMap.'''
+
+    def setUp(self):
+        self.mu = MapUser()
+        self.map_ = {'odds' : [1, 3, 5], 'evens' : [2, 4, 6], 'primes' : [2, 3, 5]}
+        self.mu.setMap(self.map_)
+
+    def testLookup(self):
+        '''Items are converted when looked up.'''
+        result = self.mu.getMap()
+        self.assertEqual(len(result), 3)
+        self.assertEqual(result['odds'], [1, 3, 5])
+        self.assertEqual(result.get('evens'), [2, 4, 6])
+        self.assertEqual(result.get('fibonacci', 0), 0)
+        self.assert_('primes' in result)
+        self.assert_('fibonacci' not in result)
+        self.assert_(10 not in result)
+        self.assertRaises(KeyError, result.__getitem__, 'fibonacci')
+
+    def testLookupWithWrongKeyType(self):
+        '''A key of the wrong type is not found, as in a dictionary.'''
+        result = self.mu.getMap()
+        self.assertRaises(KeyError, result.__getitem__, 10)
+        self.assertEqual(result.get(10, 'default'), 'default')
+        self.assertEqual(result.get(10), None)
+
+    def testIteration(self):
+        '''Iterating the proxy yields the keys in C++ map order.'''
+        result = self.mu.getMap()
+        self.assertEqual(list(result), ['evens', 'odds', 'primes'])
+        self.assertEqual(result.keys(), ['evens', 'odds', 'primes'])
+        self.assertEqual(sorted(result.items()), sorted(self.map_.items()))
+
+    def testIterator(self):
+        '''The iterator walks the C++ map one key at a time and keeps the proxy alive.'''
+        it = iter(self.mu.getMap())
+        self.assertEqual(iter(it), it)
+        self.assertEqual(it.next(), 'evens')
+        self.assertEqual(list(it), ['odds', 'primes'])
+        self.assertRaises(StopIteration, it.next)
+
+    def testIteratorsAreIndependent(self):
+        '''Each iterator has its own cursor.'''
+        result = self.mu.getMap()
+        first = iter(result)
+        second = iter(result)
+        self.assertEqual(first.next(), 'evens')
+        self.assertEqual(first.next(), 'odds')
+        self.assertEqual(second.next(), 'evens')
+
+    def testDictConversion(self):
+        '''The proxy converts to and compares equal to a dictionary.'''
+        result = self.mu.getMap()
+        self.assertEqual(dict(result), self.map_)
+        self.assertEqual(type(result.copy()), dict)
+        self.assertEqual(result, self.map_)
+
+    def testPassBackToCpp(self):
+        '''The proxy is accepted where a map is expected.'''
+        self.mu.setMap(self.mu.getMap())
+        self.assertEqual(self.mu.getMap(), self.map_)
+        self.map_['odds'].append(7)
+        self.mu.setMap(self.map_)
+        other = MapUser()
+        other.setMap(self.mu.getMap())
+        self.assertEqual(dict(other.getMap()), self.map_)
+
+    def testReadOnly(self):
+        '''The proxy does not support item assignment.'''
+        result = self.mu.getMap()
+        self.assertRaises(TypeError, result.__setitem__, 'odds', [])
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,74 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for the bulk conversion of sequences of numbers to C++ containers.'''
+
+import sys
+import unittest
+
+from sample import ContainerUser
+
+class MyInt(int):
+    pass
+
+class NumericSequenceTest(unittest.TestCase):
+    '''Test case for lists and tuples of numbers converted to containers of numbers.'''
+
+    def testIntList(self):
+        self.assertEqual(ContainerUser.sumVector(range(1000)), sum(range(1000)))
+        self.assertEqual(ContainerUser.sumVector((-5, 5, -2 ** 31, 2 ** 31 - 1)), -1)
+
+    def testFloatList(self):
+        self.assertEqual(ContainerUser.sumDoubleVector([0.5, 1.5, 2.25]), 4.25)
+        self.assertEqual(ContainerUser.sumDoubleVector(()), 0.0)
+
+    def testMixedIntAndFloatList(self):
+        '''Ints and floats go together to a container of doubles.'''
+        self.assertEqual(ContainerUser.sumDoubleVector([1, 2.5, 3, 0.25]), 6.75)
+
+    def testFloatsToIntContainer(self):
+        '''Floats aren't taken by the bulk path of integers, and are truncated item by item.'''
+        self.assertEqual(ContainerUser.sumVector([1.5, 2.5, 3]), 6)
+
+    def testOutOfRangeInt(self):
+        '''An int out of the range of the C++ type raises OverflowError.'''
+        self.assertRaises(OverflowError, ContainerUser.sumVector, [1, 2, 2 ** 31])
+        self.assertRaises(OverflowError, ContainerUser.sumVector, (-2 ** 31 - 1, 0))
+        self.assertRaises(OverflowError, ContainerUser.sumVector, [sys.maxint + 1])
+
+    def testIntSubclassAndBool(self):
+        '''Subclasses of int, and bools, are converted by the per item path.'''
+        self.assertEqual(ContainerUser.sumVector([1, MyInt(5), 2]), 8)
+        self.assertEqual(ContainerUser.sumVector([1, True, False, 2]), 4)
+        self.assertEqual(ContainerUser.sumDoubleVector([0.5, MyInt(2), True]), 3.5)
+
+    def testBoolList(self):
+        '''std::list<bool> takes the truth value of each item.'''
+        self.assertEqual(ContainerUser.negatedList([True, False, 2, 0]), [False, True, False, True])
+        self.assertEqual(ContainerUser.negatedList(()), [])
+
+if __name__ == '__main__':
+    unittest.main()
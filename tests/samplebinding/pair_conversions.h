@@ -1,4 +1,11 @@
+#include <sbktupleconverter.h>
+
+// Triples have no container type, they are used by the roundTripTriple module function.
+typedef std::tr1::tuple<int, double, std::string> Triple;
+
 namespace Shiboken {
 template<typename FT, typename ST>
 struct Converter<std::pair<FT, ST> > : StdPairConverter<std::pair<FT, ST> > {};
+template<>
+struct Converter<Triple> : StdTupleConverter<Triple> {};
 }
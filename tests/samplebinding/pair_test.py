@@ -95,6 +95,12 @@ class PairConversionTest(unittest.TestCase):
         self.assertNotEqual(result, pair)
         self.assertEqual(result, tuple(pair))
 
+    def testInvalidItemTypes(self):
+        '''Test that a pair is not accepted when only one of its items is convertible.'''
+        pu = PairUser()
+        self.assertRaises(TypeError, pu.sumPair, (3, 'seven'))
+        self.assertRaises(TypeError, pu.sumPair, ('three', 7.13))
+
 if __name__ == '__main__':
     unittest.main()
 
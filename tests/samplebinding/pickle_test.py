@@ -0,0 +1,129 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for pickling trivially copyable value types.'''
+
+import copy
+import cPickle
+import pickle
+import unittest
+
+from sample import Point, PointF, Size, SizeF
+
+class ExtendedSize(Size):
+    pass
+
+class PickleTest(unittest.TestCase):
+    '''Test case for __reduce__ and __setstate__ of value types.'''
+
+    def testPickleProtocols(self):
+        size = Size(1.5, -2.0)
+        for protocol in range(pickle.HIGHEST_PROTOCOL + 1):
+            for module in (pickle, cPickle):
+                result = module.loads(module.dumps(size, protocol))
+                self.assertEqual(type(result), Size)
+                self.assertEqual(result, size)
+                self.assertFalse(result is size)
+
+    def testRawState(self):
+        '''The generated __reduce__ pickles the bytes of the C++ object.'''
+        state = Size(10, 20).__reduce__()[2]
+        self.assertEqual(type(state), str)
+
+    def testTypeSystemReduce(self):
+        '''A __reduce__ written in the type system is kept, and pickles through the constructor.'''
+        self.assertEqual(Point(1.5, 2.0).__reduce__(), (Point, (1.5, 2.0)))
+        self.assertEqual(PointF(3.0, 4.5).__reduce__(), (PointF, (3.0, 4.5)))
+        self.assertFalse(hasattr(Point, '__setstate__'))
+        self.assertFalse(hasattr(PointF, '__setstate__'))
+        result = pickle.loads(pickle.dumps(PointF(3.0, 4.5), pickle.HIGHEST_PROTOCOL))
+        self.assertEqual((result.x(), result.y()), (3.0, 4.5))
+
+    def testInlineStorage(self):
+        '''SizeF keeps its C++ object inside the wrapper, and is pickled as its bytes.'''
+        size = SizeF(3.0, 4.5)
+        self.assertEqual(type(size.__reduce__()[2]), str)
+        result = pickle.loads(pickle.dumps(size, pickle.HIGHEST_PROTOCOL))
+        self.assertEqual((result.width(), result.height()), (3.0, 4.5))
+
+    def testDeepCopy(self):
+        size = Size(5, 6)
+        result = copy.deepcopy([size, size])
+        self.assertEqual(result[0], size)
+        self.assertTrue(result[0] is result[1])
+
+    def testSubclass(self):
+        '''Python subclasses keep their class and instance attributes.'''
+        size = ExtendedSize(7, 8)
+        size.label = 'corner'
+        result = pickle.loads(pickle.dumps(size, pickle.HIGHEST_PROTOCOL))
+        self.assertEqual(type(result), ExtendedSize)
+        self.assertEqual(result.label, 'corner')
+        self.assertEqual(result, Size(7, 8))
+
+    def testSetState(self):
+        size = Size()
+        size.__setstate__(Size(9, 10).__reduce__()[2])
+        self.assertEqual(size, Size(9, 10))
+
+    def testInvalidState(self):
+        size = Size()
+        self.assertRaises(TypeError, size.__setstate__, 123)
+        self.assertRaises(ValueError, size.__setstate__, 'abc')
+
+class PackListTest(unittest.TestCase):
+    '''Test case for the bulk packList and unpackList static methods.'''
+
+    def testRoundTrip(self):
+        sizes = [Size(i, -i) for i in range(100)]
+        data = Size.packList(sizes)
+        self.assertEqual(type(data), str)
+        self.assertEqual(Size.unpackList(data), sizes)
+
+    def testPickledList(self):
+        sizes = [Size(i, i * 2) for i in range(10)]
+        data = pickle.dumps(Size.packList(sizes), pickle.HIGHEST_PROTOCOL)
+        self.assertEqual(Size.unpackList(pickle.loads(data)), sizes)
+
+    def testInlineStorage(self):
+        points = [PointF(i, 0.5) for i in range(10)]
+        result = PointF.unpackList(PointF.packList(points))
+        self.assertEqual([(pt.x(), pt.y()) for pt in result], [(i, 0.5) for i in range(10)])
+
+    def testEmpty(self):
+        self.assertEqual(Size.unpackList(Size.packList([])), [])
+
+    def testInvalidItems(self):
+        self.assertRaises(TypeError, Size.packList, [Size(), Point()])
+        self.assertRaises(TypeError, Size.packList, 123)
+
+    def testInvalidData(self):
+        data = Size.packList([Size(1, 2)])
+        self.assertRaises(ValueError, Size.unpackList, data[:-1])
+
+if __name__ == '__main__':
+    unittest.main()
+
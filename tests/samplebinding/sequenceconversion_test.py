@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for sequences converted to C++ containers while the overloads are checked.'''
+
+import unittest
+
+from sample import ContainerUser, ListUser, Point, PointF
+
+class Sequence(object):
+    '''A Python sequence that is neither a list nor a tuple.'''
+
+    def __init__(self, items):
+        self.items = items
+
+    def __len__(self):
+        return len(self.items)
+
+    def __getitem__(self, index):
+        return self.items[index]
+
+class SequenceConversionTest(unittest.TestCase):
+    '''Test case for the conversion of list, tuple and other sequence arguments.'''
+
+    def testList(self):
+        lu = ListUser()
+        lu.setList([3, 5, 7])
+        self.assertEqual(lu.getList(), [3, 5, 7])
+        self.assertEqual(ContainerUser.sumVector([1, 2, 3]), 6)
+
+    def testTuple(self):
+        lu = ListUser()
+        lu.setList((3, 5, 7))
+        self.assertEqual(lu.getList(), [3, 5, 7])
+        self.assertEqual(ContainerUser.reversedDeque((1, 2, 3)), [3, 2, 1])
+
+    def testGenericSequence(self):
+        lu = ListUser()
+        lu.setList(Sequence([3, 5, 7]))
+        self.assertEqual(lu.getList(), [3, 5, 7])
+        self.assertEqual(ContainerUser.sumVector(xrange(5)), 10)
+
+    def testEmptySequence(self):
+        self.assertEqual(ContainerUser.sumVector([]), 0)
+
+    def testFallbackToOtherOverload(self):
+        '''An item that doesn't convert makes the decisor try the next overload.'''
+        self.assertEqual(ListUser.listOfPoints([Point(), Point()]), ListUser.ListOfPoint)
+        self.assertEqual(ListUser.listOfPoints([PointF(), PointF()]), ListUser.ListOfPointF)
+        # Point is implicitly convertible to PointF, but not the other way around.
+        self.assertEqual(ListUser.listOfPoints((PointF(), Point())), ListUser.ListOfPointF)
+        self.assertEqual(ListUser.listOfPoints(Sequence([Point(), PointF()])), ListUser.ListOfPointF)
+
+    def testInvalidItems(self):
+        self.assertRaises(TypeError, ListUser.listOfPoints, [Point(), 'point'])
+        self.assertRaises(TypeError, ContainerUser.sumVector, [1, 'two'])
+
+    def testOverflowingItem(self):
+        '''Items accepted by the check but out of range still raise OverflowError.'''
+        self.assertRaises(OverflowError, ContainerUser.sumVector, [1, 2 ** 40])
+
+if __name__ == '__main__':
+    unittest.main()
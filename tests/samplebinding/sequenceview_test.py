@@ -0,0 +1,72 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for lists returned as lazy sequence views.'''
+
+import unittest
+
+from sample import Collector
+
+class SequenceViewTest(unittest.TestCase):
+    '''Test case for the sequence view returned by Collector.items.'''
+
+    def setUp(self):
+        self.collector = Collector()
+        for value in (2, 3, 5, 7, 11):
+            self.collector << value
+
+    def testIndexing(self):
+        '''Items are converted when indexed.'''
+        items = self.collector.items()
+        self.assertEqual(len(items), 5)
+        self.assertEqual(items[0], 2)
+        self.assertEqual(items[4], 11)
+        self.assertEqual(items[-1], 11)
+        self.assertEqual(items[1:3], [3, 5])
+        self.assertRaises(IndexError, items.__getitem__, 5)
+
+    def testIteration(self):
+        '''The view supports the iteration protocol.'''
+        items = self.collector.items()
+        self.assertEqual([value for value in items], [2, 3, 5, 7, 11])
+        self.assertEqual(sum(items), 28)
+        self.assert_(7 in items)
+        self.assert_(4 not in items)
+
+    def testIndependentOfSource(self):
+        '''The view owns the returned container.'''
+        items = self.collector.items()
+        self.collector.clear()
+        self.assertEqual(list(items), [2, 3, 5, 7, 11])
+        self.assertEqual(self.collector.items(), [])
+
+    def testReadOnly(self):
+        '''The view does not support item assignment.'''
+        items = self.collector.items()
+        self.assertRaises(TypeError, items.__setitem__, 0, 1)
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,4 @@
+namespace Shiboken {
+template<typename T>
+struct Converter<std::set<T> > : StdSetConverter<std::set<T> > {};
+}
@@ -0,0 +1,72 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for classes whose C++ wrapper is only created for Python subclasses.'''
+
+import unittest
+
+from sample import Shape
+
+class Triangle(Shape):
+    def sides(self):
+        return 3
+
+class ShapeTest(unittest.TestCase):
+    '''Test case for the cpp-wrapper-only-for-subclasses generator option.'''
+
+    def testExactTypeVirtualCall(self):
+        '''Virtual calls from C++ on an exact type object use the C++ implementation.'''
+        shape = Shape(4)
+        self.assertEqual(shape.sides(), 4)
+        self.assertEqual(shape.callSides(), 4)
+
+    def testExactTypeDoesNotLookForOverrides(self):
+        '''C++ does not look at Python when calling virtual methods of exact type objects.'''
+        shape = Shape(4)
+        shape.sides = lambda: 5
+        self.assertEqual(shape.callSides(), 4)
+
+    def testSubclassOverride(self):
+        '''Python subclasses still get their virtual methods called from C++.'''
+        triangle = Triangle()
+        self.assertEqual(triangle.sides(), 3)
+        self.assertEqual(triangle.callSides(), 3)
+
+    def testSubclassInstanceOverride(self):
+        '''Methods assigned to instances of Python subclasses are still seen by C++.'''
+        triangle = Triangle()
+        triangle.sides = lambda: 6
+        self.assertEqual(triangle.callSides(), 6)
+
+    def testDestruction(self):
+        '''Objects with and without C++ wrapper are destroyed normally.'''
+        shapes = [Shape(i) for i in range(10)] + [Triangle() for i in range(10)]
+        self.assertEqual(sum(shape.callSides() for shape in shapes), 45 + 30)
+        del shapes
+
+if __name__ == '__main__':
+    unittest.main()
+
@@ -0,0 +1,79 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for C++ lists shared with Python.'''
+
+import unittest
+
+from sample import ListUser, createSharedIntList
+
+class SharedListTest(unittest.TestCase):
+    '''Test case for lists passed by reference to C++ without copies.'''
+
+    def testSequenceProtocol(self):
+        '''A shared list behaves like a Python list.'''
+        values = createSharedIntList([1, 2, 3])
+        self.assertEqual(len(values), 3)
+        self.assertEqual(values[1], 2)
+        self.assertEqual(values[-1], 3)
+        self.assertEqual(list(values), [1, 2, 3])
+        self.assert_(2 in values)
+        self.assertRaises(IndexError, values.__getitem__, 3)
+
+    def testPythonModifications(self):
+        '''Python code modifies the C++ list in place.'''
+        values = createSharedIntList([])
+        values.append(4)
+        values.extend([5, 6])
+        values[0] = 1
+        self.assertEqual(values, [1, 5, 6])
+        self.assertRaises(TypeError, values.append, 'seven')
+        self.assertRaises(TypeError, values.__setitem__, 0, 'one')
+        values.clear()
+        self.assertEqual(len(values), 0)
+
+    def testModifiedByCpp(self):
+        '''C++ functions taking the list by reference modify the shared list.'''
+        values = createSharedIntList([1, 2, 3])
+        ListUser.multiplyList(values, 2)
+        self.assertEqual(values, [2, 4, 6])
+        ListUser.multiplyList(values, 3)
+        self.assertEqual(values, [6, 12, 18])
+
+    def testPythonList(self):
+        '''Python lists are still accepted, as copies.'''
+        values = [1, 2, 3]
+        ListUser.multiplyList(values, 2)
+        self.assertEqual(values, [1, 2, 3])
+
+    def testAcceptedByValue(self):
+        '''Shared lists are accepted by functions taking the list by value.'''
+        lu = ListUser()
+        lu.setList(createSharedIntList([7, 8]))
+        self.assertEqual(lu.getList(), [7, 8])
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for the memory accounting of wrappers.'''
+
+import sys
+import unittest
+
+from sample import ObjectType, Point, PointF, Str, memoryUsage
+
+class SizeOfTest(unittest.TestCase):
+    '''Test case for __sizeof__ on wrapped objects.'''
+
+    def testIncludesCppObject(self):
+        '''The size of a wrapper is bigger than its Python object.'''
+        self.assertTrue(Point().__sizeof__() > Point.__basicsize__)
+        self.assertTrue(sys.getsizeof(Point()) > Point.__basicsize__)
+
+    def testInlineValueType(self):
+        '''Objects stored inline are not counted twice.'''
+        self.assertTrue(PointF().__sizeof__() > PointF.__basicsize__)
+        self.assertTrue(PointF().__sizeof__() < PointF.__basicsize__ + Point().__sizeof__())
+
+    def testCustomSizeFunction(self):
+        '''A size function set in the type system accounts for memory owned by the C++ object.'''
+        small = Str('')
+        big = Str('x' * 1000)
+        self.assertTrue(big.__sizeof__() - small.__sizeof__() >= 1000)
+
+    def testChildren(self):
+        '''Parent information is accounted to the parent.'''
+        parent = ObjectType()
+        size = parent.__sizeof__()
+        children = [ObjectType(parent) for i in range(10)]
+        self.assertTrue(parent.__sizeof__() > size)
+
+    def testInvalidObject(self):
+        '''The C++ object is not counted after it is lost to C++.'''
+        parent = ObjectType()
+        child = ObjectType(parent)
+        child.setObjectName('child')
+        size = child.__sizeof__()
+        parent.killChild('child')
+        self.assertTrue(child.__sizeof__() < size)
+
+class MemoryUsageTest(unittest.TestCase):
+    '''Test case for the totals of live wrappers per type.'''
+
+    def testCreateAndDestroy(self):
+        '''The totals of a type follow the wrappers created and destroyed.'''
+        objects, size = memoryUsage(Str)
+        strings = [Str('x' * 1000) for i in range(10)]
+        self.assertEqual(memoryUsage(Str), (objects + 10, size + sum(s.__sizeof__() for s in strings)))
+        del strings
+        self.assertEqual(memoryUsage(Str), (objects, size))
+
+    def testExactType(self):
+        '''Wrappers are accounted to their exact type.'''
+        objects, size = memoryUsage(PointF)
+        point = Point()
+        self.assertEqual(memoryUsage(PointF), (objects, size))
+        self.assertTrue(memoryUsage(Point)[0] > 0)
+
+    def testInvalidArgument(self):
+        self.assertRaises(TypeError, memoryUsage, 1)
+
+if __name__ == '__main__':
+    unittest.main()
+
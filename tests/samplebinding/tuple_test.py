@@ -0,0 +1,61 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+
+'''Test cases for std::tr1::tuple conversions.'''
+
+import unittest
+
+from sample import roundTripTriple
+
+class TupleConversionTest(unittest.TestCase):
+    '''Test case for the conversion of a C++ triple from and to Python.'''
+
+    def testExactTuple(self):
+        '''Exact tuples are converted item by item.'''
+        self.assertEqual(roundTripTriple((1, 2.5, 'three')), (1, 2.5, 'three'))
+
+    def testSequence(self):
+        '''Other sequences are accepted and converted back to tuples.'''
+        self.assertEqual(roundTripTriple([1, 2.5, 'three']), (1, 2.5, 'three'))
+
+    def testConvertedItems(self):
+        '''Items are converted to the types of the tuple elements.'''
+        result = roundTripTriple((1, 2, 'three'))
+        self.assertEqual(type(result[1]), float)
+
+    def testInvalidItem(self):
+        '''Tuples with any item of the wrong type are rejected.'''
+        self.assertRaises(TypeError, roundTripTriple, (1, 'two', 'three'))
+        self.assertRaises(TypeError, roundTripTriple, ('one', 2.5, 'three'))
+
+    def testInvalidSize(self):
+        '''Tuples of the wrong size are rejected.'''
+        self.assertRaises(TypeError, roundTripTriple, (1, 2.5))
+        self.assertRaises(TypeError, roundTripTriple, (1, 2.5, 'three', 4))
+
+if __name__ == '__main__':
+    unittest.main()
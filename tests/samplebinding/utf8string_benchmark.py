@@ -0,0 +1,48 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Compares the time taken to pass str and unicode objects to const char* arguments.
+
+Not part of the test suite, run it directly with the sample module in the path.
+'''
+
+import timeit
+
+from sample import Echo, Str
+
+def measure(function, arg, number=100000):
+    return min(timeit.repeat(lambda: function(arg), number=number, repeat=5))
+
+def main():
+    texts = ('short', 'a longer string with some more words in it, still below the buffer size')
+    for label, function in (('Str', Str), ('Echo.echo', Echo().echo)):
+        for text in texts:
+            print '%-10s %3d chars: str %.4fs  unicode %.4fs  non-ASCII unicode %.4fs' % \
+                  (label, len(text), measure(function, text), measure(function, unicode(text)),
+                   measure(function, unicode(text) + u'\xe9'))
+
+if __name__ == '__main__':
+    main()
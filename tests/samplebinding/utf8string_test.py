@@ -0,0 +1,66 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# This file is part of the Shiboken Python Bindings Generator project.
+#
+# Copyright (C) 2011 Nokia Corporation and/or its subsidiary(-ies).
+#
+# Contact: PySide team <contact@pyside.org>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public License
+# version 2.1 as published by the Free Software Foundation. Please
+# review the following information to ensure the GNU Lesser General
+# Public License version 2.1 requirements will be met:
+# http://www.gnu.org/licenses/old-licenses/lgpl-2.1.html.
+# #
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public
+# License along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+# 02110-1301 USA
+
+'''Test cases for passing unicode objects to const char* and std::string arguments.'''
+
+import unittest
+
+from sample import Data, Echo, Str
+
+class Utf8StringArgumentTest(unittest.TestCase):
+    '''Test case for unicode objects converted to UTF-8 strings.'''
+
+    def testConstCharPointer(self):
+        self.assertEqual(str(Str(u'hello')), 'hello')
+        self.assertEqual(Str(u'h\xe9llo').cstring(), 'h\xc3\xa9llo')
+        self.assertEqual(Str(u'\u20ac\U0001f600').cstring(), '\xe2\x82\xac\xf0\x9f\x98\x80')
+        self.assertEqual(Echo().echo(u'caf\xe9'), 'caf\xc3\xa9')
+
+    def testStdString(self):
+        self.assertEqual(Data(Data.Name, u'\xfcber').value(), '\xc3\xbcber')
+        self.assertEqual(Data(Data.Name, 'plain').value(), 'plain')
+
+    def testLongString(self):
+        '''Strings that don't fit in the call's stack buffer.'''
+        text = u'\xe9' * 1000
+        self.assertEqual(Str(text).cstring(), text.encode('utf-8'))
+
+    def testSameObject(self):
+        text = u'reused'
+        for i in range(3):
+            self.assertEqual(Echo().echo(text), 'reused')
+
+    def testStrUnchanged(self):
+        self.assertEqual(Str('abc').cstring(), 'abc')
+        self.assertEqual(Str().cstring(), '')
+        self.assertEqual(Echo().echo('abc'), 'abc')
+
+    def testInvalidArguments(self):
+        self.assertRaises(TypeError, Echo().echo, 1)
+        self.assertRaises(TypeError, Data, Data.Name, None)
+
+if __name__ == '__main__':
+    unittest.main()
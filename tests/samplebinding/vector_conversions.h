@@ -0,0 +1,4 @@
+namespace Shiboken {
+template<typename T>
+struct Converter<std::vector<T> > : StdListConverter<std::vector<T> > {};
+}